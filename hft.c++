@@ -3,6 +3,7 @@
 #include <mutex>
 #include <condition_variable>
 #include <queue>
+#include <deque>
 #include <vector>
 #include <atomic>
 #include <chrono>
@@ -10,9 +11,36 @@
 #include <memory>
 #include <map>
 #include <string>
+#include <sstream>
+#include <fstream>
 #include <iomanip>
 #include <algorithm>
 #include <cstdlib>
+#include <cstdint>
+#include <cmath>
+#include <cstring>
+#include <array>
+#include <unordered_map>
+#include <stdexcept>
+#include <type_traits>
+#include <functional>
+#include <numeric>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include <ostream>
+#include <cerrno>
+#include <cstdarg>
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "hft_plugin.h"
 
 // Forward declarations
 struct MarketData;
@@ -27,11 +55,85 @@ class HFTEngine;
 
 enum class OrderType { BUY, SELL };
 enum class OrderStatus { PENDING, FILLED, CANCELLED };
-enum class StrategyType { MARKET_MAKING, ARBITRAGE, MOMENTUM, MEAN_REVERSION };
+enum class OrderAction : uint8_t { NEW, AMEND, CANCEL };   // AMEND/CANCEL refer to a live order id
+enum class StrategyType {
+    MARKET_MAKING, ARBITRAGE, MOMENTUM, MEAN_REVERSION, CROSS_VENUE_ARBITRAGE, TRIANGULAR_ARBITRAGE, PLUGIN
+};
+constexpr size_t kNumStrategyTypes = 7;
+
+using SymbolId = uint16_t;
+
+// Venues - independent markets quoting the same symbols; venue 0 is the lead
+using VenueId = uint8_t;
+constexpr VenueId kLeadVenue = 0;
+constexpr size_t kMaxVenues = 8;
+
+// Relative price distances (mid-normalized) are expressed in basis points
+constexpr double kBasisPointsPerUnit = 1e4;
+
+// Symbol Table - interns instrument names into dense ids (setup path only)
+class SymbolTable {
+public:
+    static constexpr size_t kMaxSymbols = 4096;
+
+    static SymbolTable& instance() {
+        static SymbolTable table;
+        return table;
+    }
+
+    SymbolId intern(const std::string& name) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = ids_.find(name);
+        if (it != ids_.end()) return it->second;
+
+        size_t count = count_.load(std::memory_order_relaxed);
+        if (count == kMaxSymbols) {
+            throw std::length_error("SymbolTable: too many symbols");
+        }
+        names_[count] = name;
+        ids_.emplace(name, static_cast<SymbolId>(count));
+        count_.store(count + 1, std::memory_order_release);
+        return static_cast<SymbolId>(count);
+    }
+
+    const std::string& name(SymbolId id) const { return names_[id]; }
+    size_t size() const { return count_.load(std::memory_order_acquire); }
+
+private:
+    SymbolTable() : count_(0) { intern(""); }  // id 0 is the empty symbol
+
+    std::array<std::string, kMaxSymbols> names_;
+    std::unordered_map<std::string, SymbolId> ids_;
+    std::atomic<size_t> count_;
+    std::mutex mutex_;
+};
+
+// Symbol - trivially copyable handle to an interned instrument name
+class Symbol {
+private:
+    SymbolId id_;
+
+public:
+    Symbol() : id_(0) {}
+    explicit Symbol(SymbolId id) : id_(id) {}
+    Symbol(const std::string& name) : id_(SymbolTable::instance().intern(name)) {}
+    Symbol(const char* name) : id_(SymbolTable::instance().intern(name)) {}
+
+    SymbolId id() const { return id_; }
+    const std::string& str() const { return SymbolTable::instance().name(id_); }
+
+    bool operator==(const Symbol& other) const { return id_ == other.id_; }
+    bool operator!=(const Symbol& other) const { return id_ != other.id_; }
+};
+
+inline std::ostream& operator<<(std::ostream& os, const Symbol& symbol) {
+    return os << symbol.str();
+}
 
 // Market Data Structure
 struct MarketData {
-    std::string symbol;
+    Symbol symbol;
+    VenueId venue;
     double price;
     double volume;
     double bid;
@@ -39,15 +141,19 @@ struct MarketData {
     double spread;
     std::chrono::high_resolution_clock::time_point timestamp;
     
-    MarketData(const std::string& sym, double p, double v, double b, double a) 
-        : symbol(sym), price(p), volume(v), bid(b), ask(a), 
+    MarketData() : venue(kLeadVenue), price(0), volume(0), bid(0), ask(0), spread(0) {}
+
+    MarketData(Symbol sym, double p, double v, double b, double a, VenueId vn = kLeadVenue) 
+        : symbol(sym), venue(vn), price(p), volume(v), bid(b), ask(a), 
           spread(a - b), timestamp(std::chrono::high_resolution_clock::now()) {}
 };
 
 // Order Structure
 struct Order {
     uint64_t id;
-    std::string symbol;
+    Symbol symbol;
+    VenueId venue;
+    OrderAction action;
     OrderType type;
     double price;
     double quantity;
@@ -55,436 +161,5029 @@ struct Order {
     std::chrono::high_resolution_clock::time_point timestamp;
     StrategyType strategy;
     
-    Order(uint64_t oid, const std::string& sym, OrderType t, double p, double q, StrategyType st)
-        : id(oid), symbol(sym), type(t), price(p), quantity(q), 
+    Order() : id(0), venue(kLeadVenue), action(OrderAction::NEW), type(OrderType::BUY), price(0), quantity(0), 
+              status(OrderStatus::PENDING), strategy(StrategyType::MARKET_MAKING) {}
+
+    Order(uint64_t oid, Symbol sym, OrderType t, double p, double q, StrategyType st)
+        : id(oid), symbol(sym), venue(kLeadVenue), action(OrderAction::NEW), type(t), price(p), quantity(q), 
           status(OrderStatus::PENDING), timestamp(std::chrono::high_resolution_clock::now()),
           strategy(st) {}
 };
 
+// Queue Overflow Policies (applied once a bounded queue reaches capacity)
+enum class OverflowPolicy { BLOCK, DROP_OLDEST, DROP_NEWEST, CONFLATE };
+
+// Conflation key for queue items; specialize for types that support CONFLATE
+template<typename T>
+struct ConflationKey {
+    static constexpr bool supported = false;
+    static constexpr size_t kKeySpace = 0;
+    static size_t get(const T&) { return 0; }
+};
+
+template<>
+struct ConflationKey<MarketData> {
+    static constexpr bool supported = true;
+    static constexpr size_t kKeySpace = kMaxVenues * SymbolTable::kMaxSymbols;
+    static size_t get(const MarketData& data) {
+        return data.venue * SymbolTable::kMaxSymbols + data.symbol.id();
+    }
+};
+
 // Thread-Safe Queue Template
 template<typename T>
 class ThreadSafeQueue {
 private:
-    std::queue<T> queue_;
+    static constexpr uint64_t kNoEntry = ~uint64_t(0);
+
+    std::deque<T> queue_;
     mutable std::mutex mutex_;
     std::condition_variable condition_;
+    std::condition_variable not_full_;
+    size_t capacity_;                       // 0 = unbounded
+    OverflowPolicy policy_;
+    bool closed_ = false;
+
+    // Written under the lock, read without it by monitoring
+    std::atomic<size_t> depth_{0};
+    std::atomic<size_t> high_water_{0};
+
+    // CONFLATE: absolute sequence of the queued item for each key
+    std::vector<uint64_t> latest_;
+    uint64_t head_seq_ = 0;
+
+    std::atomic<uint64_t> dropped_{0};     // queued items evicted to make room
+    std::atomic<uint64_t> conflated_{0};
 
 public:
-    void push(const T& item) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        queue_.push(item);
+    explicit ThreadSafeQueue(size_t capacity = 0, OverflowPolicy policy = OverflowPolicy::BLOCK)
+        : capacity_(capacity), policy_(policy) {
+        if (policy_ == OverflowPolicy::CONFLATE) {
+            if (!ConflationKey<T>::supported) {
+                throw std::invalid_argument("ThreadSafeQueue: item type has no conflation key");
+            }
+            latest_.assign(ConflationKey<T>::kKeySpace, kNoEntry);
+        }
+    }
+
+    // Returns false if the item was not enqueued (dropped or queue closed)
+    bool push(const T& item) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (closed_) return false;
+
+        if (policy_ == OverflowPolicy::CONFLATE) {
+            uint64_t& seq = latest_[ConflationKey<T>::get(item)];
+            if (seq != kNoEntry) {
+                // Overwrite the queued tick in place; it keeps its queue position
+                queue_[seq - head_seq_] = item;
+                conflated_.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+
+        if (capacity_ != 0 && queue_.size() >= capacity_) {
+            switch (policy_) {
+                case OverflowPolicy::BLOCK:
+                    not_full_.wait(lock, [this] { return closed_ || queue_.size() < capacity_; });
+                    if (closed_) return false;
+                    break;
+                case OverflowPolicy::DROP_NEWEST:
+                    return false;                   // the caller counts its rejected item
+                case OverflowPolicy::DROP_OLDEST:
+                case OverflowPolicy::CONFLATE:
+                    popFront();
+                    dropped_.fetch_add(1, std::memory_order_relaxed);
+                    break;
+            }
+        }
+
+        if (policy_ == OverflowPolicy::CONFLATE) {
+            latest_[ConflationKey<T>::get(item)] = head_seq_ + queue_.size();
+        }
+        queue_.push_back(item);
+        depth_.store(queue_.size(), std::memory_order_relaxed);
+        if (queue_.size() > high_water_.load(std::memory_order_relaxed)) {
+            high_water_.store(queue_.size(), std::memory_order_relaxed);
+        }
         condition_.notify_one();
+        return true;
     }
 
     bool pop(T& item, const std::chrono::milliseconds& timeout = std::chrono::milliseconds(100)) {
         std::unique_lock<std::mutex> lock(mutex_);
-        if (condition_.wait_for(lock, timeout, [this] { return !queue_.empty(); })) {
+        if (condition_.wait_for(lock, timeout, [this] { return closed_ || !queue_.empty(); }) &&
+            !queue_.empty()) {
             item = queue_.front();
-            queue_.pop();
+            popFront();
+            if (capacity_ != 0) not_full_.notify_one();
             return true;
         }
         return false;
     }
 
-    size_t size() const {
-        std::lock_guard<std::mutex> lock(mutex_);
-        return queue_.size();
+    // Appends up to max items to out under one lock acquisition; waits like
+    // pop() when empty. Returns the number of items taken.
+    size_t popBatch(std::vector<T>& out, size_t max,
+                    const std::chrono::milliseconds& timeout = std::chrono::milliseconds(100)) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (!condition_.wait_for(lock, timeout, [this] { return closed_ || !queue_.empty(); })) return 0;
+        size_t count = std::min(max, queue_.size());
+        for (size_t i = 0; i < count; ++i) {
+            out.push_back(queue_.front());
+            popFront();
+        }
+        if (capacity_ != 0 && count != 0) not_full_.notify_all();
+        return count;
     }
 
-    bool empty() const {
+    // Wakes all waiters; later pushes fail and pops drain what is left
+    void close() {
         std::lock_guard<std::mutex> lock(mutex_);
-        return queue_.empty();
+        closed_ = true;
+        condition_.notify_all();
+        not_full_.notify_all();
     }
-};
 
-// Order Book Class
-class OrderBook {
-private:
-    std::map<double, double> bids_;  // price -> quantity
-    std::map<double, double> asks_;  // price -> quantity
-    mutable std::mutex mutex_;
+    // Lock-free reads of the depth as of the last push or pop
+    size_t size() const { return depth_.load(std::memory_order_relaxed); }
+    bool empty() const { return size() == 0; }
+    size_t highWaterMark() const { return high_water_.load(std::memory_order_relaxed); }
 
-public:
-    void updateBid(double price, double quantity) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        if (quantity > 0) {
-            bids_[price] = quantity;
-        } else {
-            bids_.erase(price);
+    // Items evicted after being queued (DROP_OLDEST, CONFLATE); a DROP_NEWEST
+    // drop is only reported by push() returning false
+    uint64_t droppedCount() const { return dropped_.load(std::memory_order_relaxed); }
+    uint64_t conflatedCount() const { return conflated_.load(std::memory_order_relaxed); }
+
+private:
+    void popFront() {
+        if (policy_ == OverflowPolicy::CONFLATE) {
+            latest_[ConflationKey<T>::get(queue_.front())] = kNoEntry;
         }
+        queue_.pop_front();
+        depth_.store(queue_.size(), std::memory_order_relaxed);
+        ++head_seq_;
     }
+};
 
-    void updateAsk(double price, double quantity) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        if (quantity > 0) {
-            asks_[price] = quantity;
-        } else {
-            asks_.erase(price);
-        }
+// Seqlock - single-writer/multi-reader snapshots of a trivially copyable
+// value. Readers never block the writer; they retry if a write overlapped.
+template<typename T>
+class Seqlock {
+    static_assert(std::is_trivially_copyable<T>::value, "Seqlock requires a trivially copyable type");
+
+private:
+    alignas(64) std::atomic<uint64_t> sequence_{0};
+    T value_{};
+
+public:
+    void store(const T& value) {
+        uint64_t seq = sequence_.load(std::memory_order_relaxed);
+        sequence_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(static_cast<void*>(&value_), &value, sizeof(T));
+        sequence_.store(seq + 2, std::memory_order_release);
     }
 
-    std::pair<double, double> getBestBidAsk() const {
-        std::lock_guard<std::mutex> lock(mutex_);
-        double bestBid = bids_.empty() ? 0.0 : bids_.rbegin()->first;
-        double bestAsk = asks_.empty() ? 0.0 : asks_.begin()->first;
-        return {bestBid, bestAsk};
+    // Returns false if a write was in progress or overlapped the copy
+    bool tryLoad(T& out) const {
+        uint64_t version;
+        return tryLoad(out, version);
     }
 
-    double getSpread() const {
-        auto [bid, ask] = getBestBidAsk();
-        return (bid > 0 && ask > 0) ? ask - bid : 0.0;
+    // Also reports the version the copy was taken at
+    bool tryLoad(T& out, uint64_t& version) const {
+        version = sequence_.load(std::memory_order_acquire);
+        if (version & 1) return false;
+        std::memcpy(static_cast<void*>(&out), &value_, sizeof(T));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return sequence_.load(std::memory_order_relaxed) == version;
     }
 
-    void printOrderBook(int depth = 5) const {
-        std::lock_guard<std::mutex> lock(mutex_);
-        std::cout << "\n=== ORDER BOOK ===" << std::endl;
-        std::cout << "ASK | Price  | Size" << std::endl;
-        
-        int count = 0;
-        for (auto it = asks_.begin(); it != asks_.end() && count < depth; ++it, ++count) {
-            std::cout << "    | " << std::fixed << std::setprecision(2) 
-                     << it->first << " | " << it->second << std::endl;
-        }
-        
-        std::cout << "----+--------+-----" << std::endl;
-        
-        count = 0;
-        for (auto it = bids_.rbegin(); it != bids_.rend() && count < depth; ++it, ++count) {
-            std::cout << "BID | " << std::fixed << std::setprecision(2) 
-                     << it->first << " | " << it->second << std::endl;
+    T load() const {
+        T out;
+        while (!tryLoad(out)) {
+            std::this_thread::yield();
         }
-        std::cout << "=================" << std::endl;
+        return out;
     }
-};
 
-// Base Trading Strategy
-class TradingStrategy {
-protected:
-    StrategyType type_;
-    std::atomic<bool> active_;
-    std::atomic<double> pnl_;
-    std::atomic<int> trade_count_;
+    // Even number of completed writes so far, usable as a snapshot version
+    uint64_t version() const { return sequence_.load(std::memory_order_acquire); }
+};
 
+// Epoch Domain - epoch-based reclamation for blocks readers use without
+// locks (see LiveParams). A reader thread announces the global epoch in its
+// own slot while inside an EpochGuard; a block retired at epoch E is freed
+// once no announced epoch is at or below E, i.e. once every reader that
+// could have loaded it has left its critical section. Guards nest, so only
+// the outermost pays the announcement store and fence.
+class EpochDomain {
 public:
-    TradingStrategy(StrategyType type) : type_(type), active_(true), pnl_(0.0), trade_count_(0) {}
-    virtual ~TradingStrategy() = default;
-
-    virtual std::vector<Order> generateSignals(const MarketData& data, const OrderBook& orderBook) = 0;
-    
-    void setActive(bool active) { active_ = active; }
-    bool isActive() const { return active_; }
-    double getPnL() const { return pnl_; }
-    int getTradeCount() const { return trade_count_; }
-    StrategyType getType() const { return type_; }
+    static constexpr size_t kMaxReaders = 64;
+    static constexpr uint64_t kIdle = UINT64_MAX;
 
-    virtual std::string getName() const = 0;
+    static EpochDomain& instance() {
+        static EpochDomain domain;
+        return domain;
+    }
 
-protected:
-    static uint64_t getNextOrderId() {
-        static std::atomic<uint64_t> orderId{1};
-        return orderId++;
+    void enter() {
+        Reader& reader = localReader();
+        if (reader.depth++ == 0) {
+            slots_[reader.index].epoch.store(epoch_.load(std::memory_order_acquire), std::memory_order_relaxed);
+            // Announce before loading any block; pairs with oldestReader()
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
     }
 
-    void updatePnL(double profit) {
-        double current = pnl_.load();
-        double new_pnl;
-        do {
-            current = pnl_.load();
-            new_pnl = current + profit;
-        } while (!pnl_.compare_exchange_weak(current, new_pnl));
-        trade_count_++;
+    void exit() {
+        Reader& reader = localReader();
+        if (--reader.depth == 0) slots_[reader.index].epoch.store(kIdle, std::memory_order_release);
     }
-};
 
-// Market Making Strategy
-class MarketMakingStrategy : public TradingStrategy {
-private:
-    double spread_threshold_;
-    double position_limit_;
+    // Writer side, after the old block was unlinked: the epoch it retires at
+    uint64_t retire() { return epoch_.fetch_add(1, std::memory_order_seq_cst); }
 
-public:
-    MarketMakingStrategy(double spread_thresh = 0.02, double pos_limit = 1000.0) 
-        : TradingStrategy(StrategyType::MARKET_MAKING), 
-          spread_threshold_(spread_thresh), position_limit_(pos_limit) {}
+    // Oldest epoch a reader is still inside (kIdle if none)
+    uint64_t oldestReader() const {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        uint64_t oldest = kIdle;
+        for (const auto& slot : slots_) oldest = std::min(oldest, slot.epoch.load(std::memory_order_acquire));
+        return oldest;
+    }
 
-    std::string getName() const override { return "Market Making"; }
+private:
+    struct alignas(64) ReaderSlot {
+        std::atomic<uint64_t> epoch{kIdle};
+        std::atomic<bool> claimed{false};
+    };
 
-    std::vector<Order> generateSignals(const MarketData& data, const OrderBook& orderBook) override {
-        std::vector<Order> orders;
-        if (!active_) return orders;
+    // A thread's claim on a slot, given back when the thread exits
+    struct Reader {
+        size_t index;
+        int depth;
+        ~Reader() { EpochDomain::instance().slots_[index].claimed.store(false, std::memory_order_release); }
+    };
 
-        auto [bestBid, bestAsk] = orderBook.getBestBidAsk();
-        double currentSpread = bestAsk - bestBid;
+    std::atomic<uint64_t> epoch_{1};
+    std::array<ReaderSlot, kMaxReaders> slots_;
 
-        if (currentSpread > spread_threshold_) {
-            // Place buy order slightly above best bid
-            double buyPrice = bestBid + 0.01;
-            orders.emplace_back(getNextOrderId(), data.symbol, OrderType::BUY, 
-                              buyPrice, 10.0, StrategyType::MARKET_MAKING);
+    EpochDomain() = default;
 
-            // Place sell order slightly below best ask  
-            double sellPrice = bestAsk - 0.01;
-            orders.emplace_back(getNextOrderId(), data.symbol, OrderType::SELL, 
-                               sellPrice, 10.0, StrategyType::MARKET_MAKING);
+    Reader& localReader() {
+        thread_local Reader reader{claimSlot(), 0};
+        return reader;
+    }
 
-            updatePnL((sellPrice - buyPrice) * 10.0);
+    size_t claimSlot() {
+        for (size_t i = 0; i < kMaxReaders; ++i) {
+            bool expected = false;
+            if (slots_[i].claimed.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) return i;
         }
-
-        return orders;
+        throw std::length_error("EpochDomain: too many reader threads");
     }
 };
 
-// Arbitrage Strategy
-class ArbitrageStrategy : public TradingStrategy {
+// Epoch Guard - marks the calling thread as reading LiveParams blocks
+class EpochGuard {
+public:
+    EpochGuard() { EpochDomain::instance().enter(); }
+    ~EpochGuard() { EpochDomain::instance().exit(); }
+    EpochGuard(const EpochGuard&) = delete;
+    EpochGuard& operator=(const EpochGuard&) = delete;
+};
+
+// Live Params - a parameter block an operator can replace while readers
+// use it, RCU style: publish() copies the values into a fresh block and
+// swaps the pointer, so a reader sees the old block or the new one, never
+// a mix, at the cost of one acquire load. read() is only valid inside an
+// EpochGuard and the reference must not outlive it. Replaced blocks are
+// freed by later publishes once no reader can still hold them.
+template<typename T>
+class LiveParams {
 private:
-    double min_profit_threshold_;
+    struct Retired {
+        std::unique_ptr<const T> block;
+        uint64_t epoch;
+    };
+
+    std::atomic<const T*> current_;
+    mutable std::mutex mutex_;                  // serializes writers
+    std::vector<Retired> retired_;
 
 public:
-    ArbitrageStrategy(double min_profit = 0.05) 
-        : TradingStrategy(StrategyType::ARBITRAGE), min_profit_threshold_(min_profit) {}
+    explicit LiveParams(const T& initial = T()) : current_(new T(initial)) {}
+    ~LiveParams() { delete current_.load(std::memory_order_relaxed); }
 
-    std::string getName() const override { return "Arbitrage"; }
+    LiveParams(const LiveParams&) = delete;
+    LiveParams& operator=(const LiveParams&) = delete;
 
-    std::vector<Order> generateSignals(const MarketData& data, const OrderBook& orderBook) override {
-        std::vector<Order> orders;
-        if (!active_) return orders;
+    const T& read() const { return *current_.load(std::memory_order_acquire); }
 
-        static double lastPrice = data.price;
-        double priceMove = std::abs(data.price - lastPrice);
-        
-        if (priceMove > min_profit_threshold_) {
-            if (data.price > lastPrice) {
-                orders.emplace_back(getNextOrderId(), data.symbol, OrderType::SELL, 
-                                  data.price, 5.0, StrategyType::ARBITRAGE);
-                updatePnL(priceMove * 5.0);
-            } else {
-                // Price decreased, buy low  
-                orders.emplace_back(getNextOrderId(), data.symbol, OrderType::BUY, 
-                                  data.price, 5.0, StrategyType::ARBITRAGE);
-                updatePnL(priceMove * 5.0);
-            }
-        }
-        
-        lastPrice = data.price;
-        return orders;
+    // Operator side: copy of the current values (no guard needed)
+    T snapshot() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return *current_.load(std::memory_order_relaxed);
+    }
+
+    void publish(const T& params) {
+        auto block = std::make_unique<const T>(params);
+        std::lock_guard<std::mutex> lock(mutex_);
+        const T* previous = current_.exchange(block.release(), std::memory_order_seq_cst);
+        retired_.push_back({std::unique_ptr<const T>(previous), EpochDomain::instance().retire()});
+
+        uint64_t oldest = EpochDomain::instance().oldestReader();
+        retired_.erase(std::remove_if(retired_.begin(), retired_.end(),
+                                      [oldest](const Retired& retired) { return retired.epoch < oldest; }),
+                       retired_.end());
     }
+
 };
 
-// Risk Manager
-class RiskManager {
+// SPSC Ring - bounded lock-free single-producer/single-consumer queue.
+// Head and tail live on separate cache lines and each side caches the
+// other's index, so the common case touches no shared line at all.
+template<typename T>
+class SpscRing {
 private:
-    std::atomic<double> max_position_;
-    std::atomic<double> current_position_;
-    std::atomic<double> daily_loss_limit_;
-    std::atomic<double> current_pnl_;
+    std::vector<T> buffer_;
+    size_t mask_;
+    alignas(64) std::atomic<size_t> head_{0};   // next slot to read (consumer)
+    size_t cached_tail_ = 0;
+    alignas(64) std::atomic<size_t> tail_{0};   // next slot to write (producer)
+    size_t cached_head_ = 0;
 
 public:
-    RiskManager(double max_pos = 10000.0, double loss_limit = -5000.0) 
-        : max_position_(max_pos), current_position_(0.0), 
-          daily_loss_limit_(loss_limit), current_pnl_(0.0) {}
-
-    bool checkOrder(const Order& order) {
-        double potential_position = current_position_.load();
-        if (order.type == OrderType::BUY) {
-            potential_position += order.quantity;
-        } else {
-            potential_position -= order.quantity;
-        }
-
-        if (std::abs(potential_position) > max_position_.load()) {
-            return false;
-        }
+    // Capacity is rounded up to a power of two
+    explicit SpscRing(size_t capacity) {
+        size_t size = 1;
+        while (size < capacity) size <<= 1;
+        buffer_.resize(size);
+        mask_ = size - 1;
+    }
 
-        if (current_pnl_.load() < daily_loss_limit_.load()) {
-            return false;
+    bool push(const T& item) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cached_head_ > mask_) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail - cached_head_ > mask_) return false;
         }
-
+        buffer_[tail & mask_] = item;
+        tail_.store(tail + 1, std::memory_order_release);
         return true;
     }
 
-    void updatePosition(const Order& order) {
-        double current = current_position_.load();
-        double new_position;
-        if (order.type == OrderType::BUY) {
-            do {
-                current = current_position_.load();
-                new_position = current + order.quantity;
-            } while (!current_position_.compare_exchange_weak(current, new_position));
-        } else {
-            do {
-                current = current_position_.load();
-                new_position = current - order.quantity;
-            } while (!current_position_.compare_exchange_weak(current, new_position));
+    bool pop(T& item) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cached_tail_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head == cached_tail_) return false;
         }
+        item = buffer_[head & mask_];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
     }
 
-    void updatePnL(double pnl) {
-        double current = current_pnl_.load();
-        double new_pnl;
-        do {
-            current = current_pnl_.load();
-            new_pnl = current + pnl;
-        } while (!current_pnl_.compare_exchange_weak(current, new_pnl));
+    size_t size() const {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
     }
+};
 
-    double getCurrentPosition() const { return current_position_; }
-    double getCurrentPnL() const { return current_pnl_; }
+// How a broadcast consumer relates to the producer
+enum class ConsumerMode {
+    GATING,     // producer never overwrites unread slots (until it isolates the consumer)
+    LAPPED      // producer ignores it; if overrun it skips to the newest item
 };
 
-// Market Data Feed
-class MarketDataFeed {
+// Broadcast Ring - single-producer/multi-consumer ring in the Disruptor
+// style: items are written once into preallocated seqlock slots and every
+// consumer walks them with its own cursor. The producer gates only on
+// GATING consumers; one that stalls the producer for longer than max_stall
+// is isolated (demoted to LAPPED) so it can't hold up everyone else, and
+// gates again as soon as a poll leaves it caught up with the producer.
+// Demotions and re-promotions are counted.
+template<typename T>
+class BroadcastRing {
+public:
+    static constexpr size_t kMaxConsumers = 8;
+
 private:
-    std::atomic<bool> running_;
-    std::thread feed_thread_;
-    ThreadSafeQueue<MarketData>& data_queue_;
-    std::mt19937 rng_;
-    std::uniform_real_distribution<double> price_dist_;
-    double base_price_;
+    struct alignas(64) Consumer {
+        std::atomic<uint64_t> next{0};          // next sequence to read
+        std::atomic<bool> gating{false};
+        bool wants_gating = false;              // registered GATING (set before the producer starts)
+        std::atomic<uint64_t> lapped{0};        // items skipped after being overrun
+        std::atomic<uint64_t> max_lag{0};
+    };
 
-public:
-    MarketDataFeed(ThreadSafeQueue<MarketData>& queue) 
-        : running_(false), data_queue_(queue), rng_(std::random_device{}()), 
-          price_dist_(-0.01, 0.01), base_price_(50000.0) {}
+    std::vector<Seqlock<T>> slots_;
+    size_t bits_;
+    size_t mask_;
+    std::chrono::steady_clock::duration max_stall_;
+    std::array<Consumer, kMaxConsumers> consumers_;
+    std::atomic<size_t> consumer_count_{0};
 
-    void start() {
-        running_ = true;
-        feed_thread_ = std::thread(&MarketDataFeed::feedLoop, this);
+    alignas(64) std::atomic<uint64_t> cursor_{0};   // next sequence to publish
+    uint64_t gate_cache_ = 0;                       // producer only
+    std::atomic<uint64_t> isolated_{0};
+    std::atomic<uint64_t> rejoined_{0};
+
+    std::atomic<int> waiters_{0};
+    std::mutex wait_mutex_;
+    std::condition_variable wait_condition_;
+
+public:
+    // Capacity is rounded up to a power of two
+    BroadcastRing(size_t capacity, std::chrono::microseconds max_stall)
+        : bits_(0), max_stall_(max_stall) {
+        while ((size_t(1) << bits_) < capacity) ++bits_;
+        slots_ = std::vector<Seqlock<T>>(size_t(1) << bits_);
+        mask_ = slots_.size() - 1;
     }
 
-    void stop() {
-        running_ = false;
-        if (feed_thread_.joinable()) {
-            feed_thread_.join();
+    // Register before the producer starts; the consumer begins at the
+    // current cursor. Returns the consumer id.
+    size_t addConsumer(ConsumerMode mode) {
+        size_t id = consumer_count_.load(std::memory_order_relaxed);
+        if (id == kMaxConsumers) {
+            throw std::length_error("BroadcastRing: too many consumers");
         }
+        consumers_[id].next.store(cursor_.load(std::memory_order_acquire), std::memory_order_relaxed);
+        consumers_[id].gating.store(mode == ConsumerMode::GATING, std::memory_order_relaxed);
+        consumers_[id].wants_gating = mode == ConsumerMode::GATING;
+        consumer_count_.store(id + 1, std::memory_order_release);
+        return id;
     }
 
-private:
-    void feedLoop() {
-        while (running_) {
-            // Generate random price movement
-            double price_change = price_dist_(rng_);
-            base_price_ *= (1.0 + price_change);
-            
-            double volume = 100 + (rng_() % 1000);
-            double bid = base_price_ - 0.05;
-            double ask = base_price_ + 0.05;
-
-            MarketData data("BTC/USD", base_price_, volume, bid, ask);
-            data_queue_.push(data);
+    void publish(const T& item) {
+        uint64_t sequence = cursor_.load(std::memory_order_relaxed);
+        if (sequence - gate_cache_ > mask_) waitForGatingConsumers(sequence);
+        slots_[sequence & mask_].store(item);
+        cursor_.store(sequence + 1, std::memory_order_seq_cst);
 
-            // High frequency - update every 1ms
-            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        if (waiters_.load(std::memory_order_seq_cst)) {
+            std::lock_guard<std::mutex> lock(wait_mutex_);
+            wait_condition_.notify_all();
         }
     }
-};
 
-// Order Manager
-class OrderManager {
-private:
-    std::atomic<bool> running_;
-    std::thread processing_thread_;
-    ThreadSafeQueue<Order>& order_queue_;
-    std::vector<Order> filled_orders_;
-    std::mutex filled_orders_mutex_;
+    // Calls fn(item) for up to max_batch items in sequence. Each item is
+    // copied out under its slot's seqlock, so an overrun is detected rather
+    // than read torn; the cursor is published once per batch.
+    template<typename Fn>
+    size_t poll(size_t id, Fn&& fn, size_t max_batch = 256) {
+        Consumer& consumer = consumers_[id];
+        uint64_t next = consumer.next.load(std::memory_order_relaxed);
+        uint64_t available = cursor_.load(std::memory_order_acquire);
+        if (available - next > consumer.max_lag.load(std::memory_order_relaxed)) {
+            consumer.max_lag.store(available - next, std::memory_order_relaxed);
+        }
 
-public:
-    OrderManager(ThreadSafeQueue<Order>& queue) 
-        : running_(false), order_queue_(queue) {}
+        size_t count = 0;
+        T item;
+        while (next < available && count < max_batch) {
+            uint64_t version;
+            if (available - next > mask_ ||
+                !slots_[next & mask_].tryLoad(item, version) ||
+                version != 2 * ((next >> bits_) + 1)) {
+                // Overrun: only possible once the producer stopped gating on us
+                available = cursor_.load(std::memory_order_acquire);
+                consumer.lapped.fetch_add(available - 1 - next, std::memory_order_relaxed);
+                next = available - 1;
+                continue;
+            }
+            fn(item);
+            ++next;
+            ++count;
+        }
+        consumer.next.store(next, std::memory_order_release);
 
-    void start() {
-        running_ = true;
-        processing_thread_ = std::thread(&OrderManager::processOrders, this);
+        // An isolated consumer that has caught up gates the producer again.
+        // If the producer races ahead meanwhile, the overrun is still caught
+        // by the slot versions and counted as lapped.
+        if (consumer.wants_gating && !consumer.gating.load(std::memory_order_relaxed) &&
+            next == cursor_.load(std::memory_order_acquire)) {
+            consumer.gating.store(true, std::memory_order_release);
+            rejoined_.fetch_add(1, std::memory_order_relaxed);
+        }
+        return count;
     }
 
-    void stop() {
-        running_ = false;
-        if (processing_thread_.joinable()) {
-            processing_thread_.join();
+    // Blocks until the consumer has something to read or the timeout expires
+    bool waitForData(size_t id, const std::chrono::milliseconds& timeout) {
+        uint64_t next = consumers_[id].next.load(std::memory_order_relaxed);
+        for (int spin = 0; spin < 64; ++spin) {
+            if (cursor_.load(std::memory_order_acquire) > next) return true;
         }
+        std::unique_lock<std::mutex> lock(wait_mutex_);
+        waiters_.fetch_add(1, std::memory_order_seq_cst);
+        bool ready = wait_condition_.wait_for(lock, timeout, [&] {
+            return cursor_.load(std::memory_order_seq_cst) > next;
+        });
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+        return ready;
+    }
+
+    // Discards everything published so far (e.g. while trading is halted)
+    void skip(size_t id) {
+        consumers_[id].next.store(cursor_.load(std::memory_order_acquire), std::memory_order_release);
     }
 
-    std::vector<Order> getFilledOrders() {
-        std::lock_guard<std::mutex> lock(filled_orders_mutex_);
-        return filled_orders_;
+    uint64_t publishedCount() const { return cursor_.load(std::memory_order_relaxed); }
+    uint64_t isolatedCount() const { return isolated_.load(std::memory_order_relaxed); }
+    uint64_t rejoinedCount() const { return rejoined_.load(std::memory_order_relaxed); }
+
+    size_t lag(size_t id) const {
+        return cursor_.load(std::memory_order_relaxed) - consumers_[id].next.load(std::memory_order_relaxed);
     }
+    size_t maxLag(size_t id) const { return consumers_[id].max_lag.load(std::memory_order_relaxed); }
+    uint64_t lappedCount(size_t id) const { return consumers_[id].lapped.load(std::memory_order_relaxed); }
+    bool isGating(size_t id) const { return consumers_[id].gating.load(std::memory_order_relaxed); }
 
 private:
-    void processOrders() {
-        while (running_) {
-            Order order{0, "", OrderType::BUY, 0, 0, StrategyType::MARKET_MAKING};
-            if (order_queue_.pop(order)) {
-                // Simulate order processing latency
-                std::this_thread::sleep_for(std::chrono::microseconds(100));
-                
-                // Simulate fill (90% fill rate)
-                std::random_device rd;
-                std::mt19937 gen(rd());
-                std::uniform_int_distribution<> dis(1, 10);
-                
-                if (dis(gen) <= 9) {  // 90% chance to fill
-                    order.status = OrderStatus::FILLED;
-                    
-                    std::lock_guard<std::mutex> lock(filled_orders_mutex_);
-                    filled_orders_.push_back(order);
+    // Slow path: the ring is full as far as the last known gating sequence
+    void waitForGatingConsumers(uint64_t sequence) {
+        auto deadline = std::chrono::steady_clock::now() + max_stall_;
+        while (true) {
+            size_t slowest = kMaxConsumers;
+            gate_cache_ = sequence;
+            size_t count = consumer_count_.load(std::memory_order_acquire);
+            for (size_t i = 0; i < count; ++i) {
+                if (!consumers_[i].gating.load(std::memory_order_relaxed)) continue;
+                uint64_t next = consumers_[i].next.load(std::memory_order_acquire);
+                if (next < gate_cache_) {
+                    gate_cache_ = next;
+                    slowest = i;
                 }
             }
+            if (sequence - gate_cache_ <= mask_) return;
+            if (std::chrono::steady_clock::now() >= deadline) {
+                consumers_[slowest].gating.store(false, std::memory_order_relaxed);
+                isolated_.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+            std::this_thread::yield();
         }
     }
 };
 
-// Main HFT Engine
-class HFTEngine {
+// Staged Ring - one preallocated ring of event slots worked on in place by
+// a fixed chain of stages. Stage i owns a cursor and may process any slot
+// below the cursor of stage i-1 (the producer's for stage 0); the producer
+// reuses a slot only after the last stage has passed it. Each stage handles
+// everything available in one batch and publishes its cursor once.
+template<typename T, size_t Stages>
+class StagedRing {
 private:
-    std::atomic<bool> running_;
-    std::vector<std::unique_ptr<TradingStrategy>> strategies_;
-    std::unique_ptr<RiskManager> risk_manager_;
-    std::unique_ptr<MarketDataFeed> market_feed_;
-    std::unique_ptr<OrderManager> order_manager_;
-    OrderBook order_book_;
-    
-    ThreadSafeQueue<MarketData> market_data_queue_;
-    ThreadSafeQueue<Order> order_queue_;
-    
-    std::thread engine_thread_;
-    std::thread ui_thread_;
+    struct alignas(64) Cursor {
+        std::atomic<uint64_t> value{0};
+    };
+
+    std::vector<T> slots_;
+    size_t mask_;
+    Cursor published_;
+    std::array<Cursor, Stages> cursors_;
+    uint64_t gate_cache_ = 0;                   // producer only
+    std::atomic<bool> closed_{false};
 
 public:
-    HFTEngine() : running_(false) {
-        // Initialize strategies
-        strategies_.push_back(std::make_unique<MarketMakingStrategy>());
-        strategies_.push_back(std::make_unique<ArbitrageStrategy>());
-        
-        // Initialize components
-        risk_manager_ = std::make_unique<RiskManager>();
-        market_feed_ = std::make_unique<MarketDataFeed>(market_data_queue_);
-        order_manager_ = std::make_unique<OrderManager>(order_queue_);
+    // Capacity is rounded up to a power of two
+    explicit StagedRing(size_t capacity) {
+        size_t size = 1;
+        while (size < capacity) size <<= 1;
+        slots_.resize(size);
+        mask_ = size - 1;
     }
 
-    void start() {
-        running_ = true;
-        
-        // Start all components
-        market_feed_->start();
-        order_manager_->start();
-        
-        // Start main engine loop
-        engine_thread_ = std::thread(&HFTEngine::engineLoop, this);
-        
-        // Start UI thread
-        ui_thread_ = std::thread(&HFTEngine::uiLoop, this);
-        
-        std::cout << "HFT Engine started successfully!" << std::endl;
+    // Producer: waits for a free slot, lets fill(slot) write it, then
+    // publishes it to stage 0. Returns false once the ring is closed.
+    template<typename Fn>
+    bool publish(Fn&& fill) {
+        uint64_t sequence = published_.value.load(std::memory_order_relaxed);
+        while (sequence - gate_cache_ > mask_) {
+            gate_cache_ = cursors_[Stages - 1].value.load(std::memory_order_acquire);
+            if (sequence - gate_cache_ <= mask_) break;
+            if (closed_.load(std::memory_order_relaxed)) return false;
+            std::this_thread::yield();
+        }
+        fill(slots_[sequence & mask_]);
+        published_.value.store(sequence + 1, std::memory_order_release);
+        return true;
     }
 
-    void stop() {
-        running_ = false;
-        
-        market_feed_->stop();
-        order_manager_->stop();
-        
+    // Calls fn(slot) for up to max_batch slots the upstream stage has finished
+    template<typename Fn>
+    size_t process(size_t stage, Fn&& fn, size_t max_batch = 256) {
+        uint64_t next = cursors_[stage].value.load(std::memory_order_relaxed);
+        const Cursor& upstream = stage == 0 ? published_ : cursors_[stage - 1];
+        uint64_t available = std::min(upstream.value.load(std::memory_order_acquire), next + max_batch);
+        for (uint64_t sequence = next; sequence < available; ++sequence) {
+            fn(slots_[sequence & mask_]);
+        }
+        cursors_[stage].value.store(available, std::memory_order_release);
+        return static_cast<size_t>(available - next);
+    }
+
+    // Releases a producer waiting on a stalled pipeline
+    void close() { closed_.store(true, std::memory_order_relaxed); }
+
+    // Events published but not yet past the given stage
+    size_t lag(size_t stage) const {
+        return published_.value.load(std::memory_order_relaxed) -
+               cursors_[stage].value.load(std::memory_order_relaxed);
+    }
+};
+
+// Top-of-book view published by OrderBook
+struct TopOfBook {
+    double bid;
+    double bid_quantity;
+    double ask;
+    double ask_quantity;
+};
+
+// Depth features over the best `levels` levels of each side
+struct DepthAnalytics {
+    int levels;
+    double bid_depth;                 // cumulative bid quantity
+    double ask_depth;
+    double imbalance;                 // (bid - ask) / (bid + ask), in [-1, 1]
+    double microprice;                // touch prices weighted by the opposite touch size
+    double weighted_mid;              // mean of each side's size-weighted price
+};
+
+// Versioned depth snapshot published by OrderBook
+struct BookSnapshot {
+    static constexpr int kDepth = 10;
+
+    uint64_t version;                 // number of published book updates
+    int bid_levels;
+    int ask_levels;
+    double bid_price[kDepth];
+    double bid_quantity[kDepth];
+    double ask_price[kDepth];
+    double ask_quantity[kDepth];
+    // Running totals through each level (quantity and price * quantity)
+    double bid_cum_quantity[kDepth];
+    double bid_cum_notional[kDepth];
+    double ask_cum_quantity[kDepth];
+    double ask_cum_notional[kDepth];
+
+    // O(1): every depth-N total is a single lookup in the running sums
+    DepthAnalytics analytics(int levels = kDepth) const {
+        DepthAnalytics out{levels, 0.0, 0.0, 0.0, 0.0, 0.0};
+        int bids = std::min(levels, bid_levels);
+        int asks = std::min(levels, ask_levels);
+        if (bids > 0) out.bid_depth = bid_cum_quantity[bids - 1];
+        if (asks > 0) out.ask_depth = ask_cum_quantity[asks - 1];
+        double total = out.bid_depth + out.ask_depth;
+        if (total > 0.0) out.imbalance = (out.bid_depth - out.ask_depth) / total;
+        if (bids > 0 && asks > 0) {
+            double touch = bid_quantity[0] + ask_quantity[0];
+            out.microprice = (ask_price[0] * bid_quantity[0] + bid_price[0] * ask_quantity[0]) / touch;
+            out.weighted_mid = 0.5 * (bid_cum_notional[bids - 1] / out.bid_depth +
+                                      ask_cum_notional[asks - 1] / out.ask_depth);
+        }
+        return out;
+    }
+};
+
+// Adds delta to n contiguous values; on x86 Linux (ifunc) cloned for AVX-512
+// and AVX2 and picked at load time, since it runs on every level size change
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__linux__)
+__attribute__((target_clones("avx512f", "avx2", "default")))
+#endif
+static void addToRange(double* values, size_t n, double delta) {
+    for (size_t i = 0; i < n; ++i) values[i] += delta;
+}
+
+// Book Side - one side's levels as contiguous best-first arrays with
+// running sums of quantity and notional. A size change adds the delta to
+// the sums from that level down; an insert or erase shifts the arrays and
+// rebuilds the sums from the changed level, which also clears any drift.
+// Beyond kMaxLevels the worst level falls off.
+class BookSide {
+public:
+    static constexpr size_t kMaxLevels = 64;
+
+private:
+    bool descending_;                 // bids: best is the highest price
+    size_t count_ = 0;
+    std::array<double, kMaxLevels> price_;
+    std::array<double, kMaxLevels> quantity_;
+    std::array<double, kMaxLevels> cum_quantity_;
+    std::array<double, kMaxLevels> cum_notional_;
+
+public:
+    explicit BookSide(bool descending) : descending_(descending) {}
+
+    void set(double price, double quantity) {
+        // Levels cluster near the touch, so a forward scan beats a search
+        size_t i = 0;
+        while (i < count_ && better(price_[i], price)) ++i;
+
+        if (i < count_ && price_[i] == price) {
+            if (quantity > 0) {
+                double delta = quantity - quantity_[i];
+                quantity_[i] = quantity;
+                addToRange(&cum_quantity_[i], count_ - i, delta);
+                addToRange(&cum_notional_[i], count_ - i, delta * price);
+            } else {
+                shift(i + 1, i, count_ - i - 1);
+                --count_;
+                rebuildFrom(i);
+            }
+            return;
+        }
+        if (quantity <= 0 || i == kMaxLevels) return;
+        if (count_ == kMaxLevels) --count_;
+        shift(i, i + 1, count_ - i);
+        price_[i] = price;
+        quantity_[i] = quantity;
+        ++count_;
+        rebuildFrom(i);
+    }
+
+    void clear() { count_ = 0; }
+
+    size_t size() const { return count_; }
+    double price(size_t level) const { return price_[level]; }
+    double quantity(size_t level) const { return quantity_[level]; }
+    double cumQuantity(size_t level) const { return cum_quantity_[level]; }
+    double cumNotional(size_t level) const { return cum_notional_[level]; }
+
+private:
+    bool better(double a, double b) const { return descending_ ? a > b : a < b; }
+
+    void shift(size_t from, size_t to, size_t n) {
+        std::memmove(&price_[to], &price_[from], n * sizeof(double));
+        std::memmove(&quantity_[to], &quantity_[from], n * sizeof(double));
+    }
+
+    void rebuildFrom(size_t level) {
+        double quantity = level ? cum_quantity_[level - 1] : 0.0;
+        double notional = level ? cum_notional_[level - 1] : 0.0;
+        for (size_t i = level; i < count_; ++i) {
+            quantity += quantity_[i];
+            notional += price_[i] * quantity_[i];
+            cum_quantity_[i] = quantity;
+            cum_notional_[i] = notional;
+        }
+    }
+};
+
+// Order Book Class
+// Single writer, many readers: writers mutate the level arrays and publish
+// a seqlock'd top of book plus a depth snapshot; readers (strategies, risk,
+// UI) only ever copy those snapshots, so they take no locks and can never
+// delay the writer.
+class OrderBook {
+private:
+    BookSide bids_{true};
+    BookSide asks_{false};
+    std::mutex mutex_;               // serializes writers only
+    uint64_t version_ = 0;
+    double tick_size_;               // 0 = unknown
+
+    Seqlock<TopOfBook> top_;
+    Seqlock<BookSnapshot> snapshot_;
+
+public:
+    explicit OrderBook(double tick_size = 0.0) : tick_size_(tick_size) {}
+
+    double tickSize() const { return tick_size_; }
+
+    // Groups several level changes into one published snapshot
+    class Batch {
+    private:
+        OrderBook& book_;
+        std::lock_guard<std::mutex> lock_;
+
+    public:
+        explicit Batch(OrderBook& book) : book_(book), lock_(book.mutex_) {}
+        ~Batch() { book_.publishLocked(); }
+
+        Batch(const Batch&) = delete;
+        Batch& operator=(const Batch&) = delete;
+
+        void updateBid(double price, double quantity) { book_.bids_.set(price, quantity); }
+        void updateAsk(double price, double quantity) { book_.asks_.set(price, quantity); }
+
+        void clear() {
+            book_.bids_.clear();
+            book_.asks_.clear();
+        }
+    };
+
+    void updateBid(double price, double quantity) {
+        Batch batch(*this);
+        batch.updateBid(price, quantity);
+    }
+
+    void updateAsk(double price, double quantity) {
+        Batch batch(*this);
+        batch.updateAsk(price, quantity);
+    }
+
+    std::pair<double, double> getBestBidAsk() const {
+        TopOfBook top = top_.load();
+        return {top.bid, top.ask};
+    }
+
+    TopOfBook getTopOfBook() const { return top_.load(); }
+
+    BookSnapshot getSnapshot() const { return snapshot_.load(); }
+
+    DepthAnalytics getDepthAnalytics(int levels = BookSnapshot::kDepth) const {
+        return getSnapshot().analytics(levels);
+    }
+
+    double getSpread() const {
+        auto [bid, ask] = getBestBidAsk();
+        return (bid > 0 && ask > 0) ? ask - bid : 0.0;
+    }
+
+    void printOrderBook(int depth = 5) const {
+        BookSnapshot book = getSnapshot();
+        std::cout << "\n=== ORDER BOOK ===" << std::endl;
+        std::cout << "ASK | Price  | Size" << std::endl;
+        
+        for (int i = 0; i < book.ask_levels && i < depth; ++i) {
+            std::cout << "    | " << std::fixed << std::setprecision(2) 
+                     << book.ask_price[i] << " | " << book.ask_quantity[i] << std::endl;
+        }
+        
+        std::cout << "----+--------+-----" << std::endl;
+        
+        for (int i = 0; i < book.bid_levels && i < depth; ++i) {
+            std::cout << "BID | " << std::fixed << std::setprecision(2) 
+                     << book.bid_price[i] << " | " << book.bid_quantity[i] << std::endl;
+        }
+        DepthAnalytics analytics = book.analytics(depth);
+        std::cout << "Imbalance(" << depth << "): " << analytics.imbalance
+                  << " | Microprice: " << analytics.microprice
+                  << " | Weighted Mid: " << analytics.weighted_mid << std::endl;
+        std::cout << "=================" << std::endl;
+    }
+
+private:
+    static int copySide(const BookSide& side, double* price, double* quantity,
+                        double* cum_quantity, double* cum_notional) {
+        int levels = static_cast<int>(std::min<size_t>(side.size(), BookSnapshot::kDepth));
+        for (int i = 0; i < levels; ++i) {
+            price[i] = side.price(i);
+            quantity[i] = side.quantity(i);
+            cum_quantity[i] = side.cumQuantity(i);
+            cum_notional[i] = side.cumNotional(i);
+        }
+        return levels;
+    }
+
+    void publishLocked() {
+        BookSnapshot book;
+        book.version = ++version_;
+        book.bid_levels = copySide(bids_, book.bid_price, book.bid_quantity,
+                                   book.bid_cum_quantity, book.bid_cum_notional);
+        book.ask_levels = copySide(asks_, book.ask_price, book.ask_quantity,
+                                   book.ask_cum_quantity, book.ask_cum_notional);
+
+        TopOfBook top{0.0, 0.0, 0.0, 0.0};
+        if (book.bid_levels) {
+            top.bid = book.bid_price[0];
+            top.bid_quantity = book.bid_quantity[0];
+        }
+        if (book.ask_levels) {
+            top.ask = book.ask_price[0];
+            top.ask_quantity = book.ask_quantity[0];
+        }
+        top_.store(top);
+        snapshot_.store(book);
+    }
+};
+
+// Venue Books - one OrderBook per (venue, symbol). Books are created up
+// front for the configured symbols, so lookups from any thread never
+// allocate and a venue's book only ever sees that venue's ticks.
+class VenueBooks {
+private:
+    std::vector<std::unique_ptr<OrderBook>> books_;   // [venue * kMaxSymbols + symbol]
+
+    static size_t key(VenueId venue, Symbol symbol) {
+        return venue * SymbolTable::kMaxSymbols + symbol.id();
+    }
+
+public:
+    VenueBooks() : books_(kMaxVenues * SymbolTable::kMaxSymbols) {}
+
+    void add(VenueId venue, Symbol symbol, double tick_size) {
+        if (venue >= kMaxVenues) throw std::out_of_range("VenueBooks: venue out of range");
+        auto& book = books_[key(venue, symbol)];
+        if (!book) book = std::make_unique<OrderBook>(tick_size);
+    }
+
+    OrderBook& get(VenueId venue, Symbol symbol) {
+        auto& book = books_[key(venue, symbol)];
+        if (!book) throw std::out_of_range("VenueBooks: no book for " + symbol.str());
+        return *book;
+    }
+};
+
+// Symbol Slots - dense per-owner index so indicator state can live in flat
+// arrays sized for the symbols actually traded rather than the whole table
+class SymbolSlots {
+public:
+    static constexpr uint16_t kNoSlot = 0xFFFF;
+
+private:
+    std::vector<uint16_t> slot_;
+    std::vector<Symbol> symbols_;
+    size_t capacity_;
+
+public:
+    explicit SymbolSlots(size_t capacity)
+        : slot_(SymbolTable::kMaxSymbols, kNoSlot), capacity_(std::min<size_t>(capacity, kNoSlot)) {
+        symbols_.reserve(capacity_);
+    }
+
+    // Assigns a slot on first use; kNoSlot once capacity is exhausted
+    uint16_t get(Symbol symbol) {
+        uint16_t& slot = slot_[symbol.id()];
+        if (slot == kNoSlot && symbols_.size() < capacity_) {
+            slot = static_cast<uint16_t>(symbols_.size());
+            symbols_.push_back(symbol);
+        }
+        return slot;
+    }
+
+    // Slot of a symbol without assigning one
+    uint16_t find(Symbol symbol) const { return slot_[symbol.id()]; }
+
+    Symbol symbolAt(size_t slot) const { return symbols_[slot]; }
+    size_t size() const { return symbols_.size(); }
+    size_t capacity() const { return capacity_; }
+};
+
+// Streaming indicators: O(1) per update, no allocation after construction,
+// state stored structure-of-arrays with one entry per symbol slot
+
+// Exponential moving average
+class Ema {
+private:
+    std::vector<double> value_;
+    std::vector<uint8_t> primed_;
+    double alpha_;
+
+public:
+    Ema(size_t slots, size_t period)
+        : value_(slots, 0.0), primed_(slots, 0), alpha_(2.0 / (static_cast<double>(period) + 1.0)) {}
+
+    double update(size_t slot, double x) {
+        double& value = value_[slot];
+        value = primed_[slot] ? value + alpha_ * (x - value) : x;
+        primed_[slot] = 1;
+        return value;
+    }
+
+    double value(size_t slot) const { return value_[slot]; }
+};
+
+// Rolling window statistics: Welford mean/variance updated by adding the new
+// sample and removing the one leaving the window, plus min/max from
+// monotonic deques of sample sequence numbers (no scan of the window)
+class RollingStats {
+private:
+    size_t window_;
+    std::vector<double> samples_;           // slot * window_ ring of samples
+    std::vector<uint64_t> max_deque_;       // slot * window_ sequence numbers
+    std::vector<uint64_t> min_deque_;
+    std::vector<uint64_t> sequence_;        // samples seen per slot
+    std::vector<uint64_t> max_head_, max_tail_, min_head_, min_tail_;
+    std::vector<double> mean_;
+    std::vector<double> m2_;
+
+public:
+    RollingStats(size_t slots, size_t window)
+        : window_(std::max<size_t>(window, 2)),
+          samples_(slots * window_), max_deque_(slots * window_), min_deque_(slots * window_),
+          sequence_(slots), max_head_(slots), max_tail_(slots), min_head_(slots), min_tail_(slots),
+          mean_(slots), m2_(slots) {}
+
+    void update(size_t slot, double x) {
+        const size_t base = slot * window_;
+        const uint64_t n = sequence_[slot];
+        double& sample = samples_[base + n % window_];
+        double& mean = mean_[slot];
+        double& m2 = m2_[slot];
+
+        if (n < window_) {
+            double delta = x - mean;
+            mean += delta / static_cast<double>(n + 1);
+            m2 += delta * (x - mean);
+        } else {
+            double old = sample;
+            double old_mean = mean;
+            mean += (x - old) / static_cast<double>(window_);
+            m2 = std::max(0.0, m2 + (x - old) * (x - mean + old - old_mean));
+        }
+        sample = x;
+
+        pushMonotonic(max_deque_, max_head_[slot], max_tail_[slot], base, n, [x](double v) { return v <= x; });
+        pushMonotonic(min_deque_, min_head_[slot], min_tail_[slot], base, n, [x](double v) { return v >= x; });
+        sequence_[slot] = n + 1;
+    }
+
+    size_t count(size_t slot) const { return static_cast<size_t>(std::min<uint64_t>(sequence_[slot], window_)); }
+    bool full(size_t slot) const { return sequence_[slot] >= window_; }
+    double mean(size_t slot) const { return mean_[slot]; }
+
+    double variance(size_t slot) const {
+        size_t n = count(slot);
+        return n > 1 ? m2_[slot] / static_cast<double>(n - 1) : 0.0;
+    }
+
+    double stddev(size_t slot) const { return std::sqrt(variance(slot)); }
+
+    double zscore(size_t slot, double x) const {
+        double sd = stddev(slot);
+        return sd > 0.0 ? (x - mean_[slot]) / sd : 0.0;
+    }
+
+    double max(size_t slot) const { return front(max_deque_, max_head_[slot], slot); }
+    double min(size_t slot) const { return front(min_deque_, min_head_[slot], slot); }
+
+private:
+    double valueAt(size_t base, uint64_t sequence) const { return samples_[base + sequence % window_]; }
+
+    double front(const std::vector<uint64_t>& deque, uint64_t head, size_t slot) const {
+        const size_t base = slot * window_;
+        return sequence_[slot] ? valueAt(base, deque[base + head % window_]) : 0.0;
+    }
+
+    // Drops the sample that just left the window from the front, then the
+    // samples the new one dominates from the back. Expiring first keeps at
+    // most window_ - 1 entries before the push, so the ring never overwrites
+    // its head.
+    template<typename Dominated>
+    void pushMonotonic(std::vector<uint64_t>& deque, uint64_t& head, uint64_t& tail,
+                       size_t base, uint64_t n, Dominated dominated) {
+        while (tail > head && deque[base + head % window_] + window_ <= n) ++head;
+        while (tail > head && dominated(valueAt(base, deque[base + (tail - 1) % window_]))) --tail;
+        deque[base + tail % window_] = n;
+        ++tail;
+    }
+};
+
+// Rolling volume-weighted average price over the last `window` ticks
+class RollingVwap {
+private:
+    size_t window_;
+    std::vector<double> notional_;          // slot * window_ ring of price * volume
+    std::vector<double> volume_;
+    std::vector<uint64_t> sequence_;
+    std::vector<double> notional_sum_;
+    std::vector<double> volume_sum_;
+
+public:
+    RollingVwap(size_t slots, size_t window)
+        : window_(std::max<size_t>(window, 1)), notional_(slots * window_), volume_(slots * window_),
+          sequence_(slots), notional_sum_(slots), volume_sum_(slots) {}
+
+    double update(size_t slot, double price, double volume) {
+        const size_t index = slot * window_ + sequence_[slot]++ % window_;
+        double notional = price * volume;
+        notional_sum_[slot] += notional - notional_[index];
+        volume_sum_[slot] += volume - volume_[index];
+        notional_[index] = notional;
+        volume_[index] = volume;
+        return value(slot);
+    }
+
+    double value(size_t slot) const {
+        return volume_sum_[slot] > 0.0 ? notional_sum_[slot] / volume_sum_[slot] : 0.0;
+    }
+};
+
+// Base Trading Strategy
+class TradingStrategy {
+protected:
+    StrategyType type_;
+    std::atomic<bool> active_;
+
+public:
+    TradingStrategy(StrategyType type) : type_(type), active_(true) {}
+    virtual ~TradingStrategy() = default;
+
+    virtual std::vector<Order> generateSignals(const MarketData& data, const OrderBook& orderBook) = 0;
+    
+    void setActive(bool active) { active_ = active; }
+    bool isActive() const { return active_; }
+    StrategyType getType() const { return type_; }
+
+    // Ticks from other venues are only routed to strategies that want them
+    virtual bool handlesVenue(VenueId venue) const { return venue == kLeadVenue; }
+
+    // One of this strategy's orders was refused before reaching the market
+    // (risk reject or full order queue); called on the submitting thread
+    virtual void onOrderRefused(const Order& /*order*/) {}
+
+    virtual std::string getName() const = 0;
+
+protected:
+    static uint64_t getNextOrderId() {
+        static std::atomic<uint64_t> orderId{1};
+        return orderId++;
+    }
+};
+
+// One vectorizable trigger over a strategy's per-slot columns; lane i fires when
+//   ABOVE:        (a[i] - b[i])            >  threshold * scale[i]
+//   ABS_ABOVE:   |a[i] - b[i]|             >  threshold * scale[i]
+//   SIGN_CHANGE:  (a[i] - b[i]) * scale[i] <  0
+// An infinite scale (or zero for SIGN_CHANGE) disables a lane.
+struct SignalPredicate {
+    enum Kind { ABOVE, ABS_ABOVE, SIGN_CHANGE };
+    Kind kind;
+    const double* a;
+    const double* b;
+    const double* scale;
+    double threshold;
+};
+
+inline bool evaluatePredicate(const SignalPredicate& p, size_t i) {
+    double diff = p.a[i] - p.b[i];
+    switch (p.kind) {
+        case SignalPredicate::ABOVE: return diff > p.threshold * p.scale[i];
+        case SignalPredicate::ABS_ABOVE: return std::abs(diff) > p.threshold * p.scale[i];
+        case SignalPredicate::SIGN_CHANGE: return diff * p.scale[i] < 0.0;
+    }
+    return false;
+}
+
+// Signal Kernel - evaluates a predicate over 64-lane words of slots and
+// writes one bit per slot. Uses AVX-512 or AVX2 when the CPU supports them
+// (chosen once at first use), otherwise the scalar loop.
+class SignalKernel {
+public:
+    using EvaluateFn = void (*)(const SignalPredicate&, size_t, uint64_t*);
+
+    static void evaluate(const SignalPredicate& p, size_t words, uint64_t* mask) {
+        static const EvaluateFn fn = select();
+        fn(p, words, mask);
+    }
+
+    static const char* isaName() {
+#if defined(__x86_64__) || defined(__i386__)
+        if (__builtin_cpu_supports("avx512f")) return "avx512";
+        if (__builtin_cpu_supports("avx2")) return "avx2";
+#endif
+        return "scalar";
+    }
+
+private:
+    static EvaluateFn select() {
+#if defined(__x86_64__) || defined(__i386__)
+        if (__builtin_cpu_supports("avx512f")) return evaluateAvx512;
+        if (__builtin_cpu_supports("avx2")) return evaluateAvx2;
+#endif
+        return evaluateScalar;
+    }
+
+    static void evaluateScalar(const SignalPredicate& p, size_t words, uint64_t* mask) {
+        for (size_t w = 0; w < words; ++w) {
+            uint64_t bits = 0;
+            for (size_t j = 0; j < 64; ++j) bits |= uint64_t(evaluatePredicate(p, w * 64 + j)) << j;
+            mask[w] = bits;
+        }
+    }
+
+#if defined(__x86_64__) || defined(__i386__)
+    __attribute__((target("avx2")))
+    static void evaluateAvx2(const SignalPredicate& p, size_t words, uint64_t* mask) {
+        const __m256d threshold = _mm256_set1_pd(p.threshold);
+        const __m256d sign_bit = _mm256_set1_pd(-0.0);
+        const __m256d zero = _mm256_setzero_pd();
+        for (size_t w = 0; w < words; ++w) {
+            uint64_t bits = 0;
+            for (size_t j = 0; j < 64; j += 4) {
+                size_t i = w * 64 + j;
+                __m256d diff = _mm256_sub_pd(_mm256_loadu_pd(p.a + i), _mm256_loadu_pd(p.b + i));
+                __m256d scale = _mm256_loadu_pd(p.scale + i);
+                __m256d hit;
+                switch (p.kind) {
+                    case SignalPredicate::ABOVE:
+                        hit = _mm256_cmp_pd(diff, _mm256_mul_pd(threshold, scale), _CMP_GT_OQ);
+                        break;
+                    case SignalPredicate::ABS_ABOVE:
+                        hit = _mm256_cmp_pd(_mm256_andnot_pd(sign_bit, diff), _mm256_mul_pd(threshold, scale), _CMP_GT_OQ);
+                        break;
+                    default:
+                        hit = _mm256_cmp_pd(_mm256_mul_pd(diff, scale), zero, _CMP_LT_OQ);
+                        break;
+                }
+                bits |= uint64_t(_mm256_movemask_pd(hit)) << j;
+            }
+            mask[w] = bits;
+        }
+    }
+
+    __attribute__((target("avx512f")))
+    static void evaluateAvx512(const SignalPredicate& p, size_t words, uint64_t* mask) {
+        const __m512d threshold = _mm512_set1_pd(p.threshold);
+        const __m512d zero = _mm512_setzero_pd();
+        for (size_t w = 0; w < words; ++w) {
+            uint64_t bits = 0;
+            for (size_t j = 0; j < 64; j += 8) {
+                size_t i = w * 64 + j;
+                __m512d diff = _mm512_sub_pd(_mm512_loadu_pd(p.a + i), _mm512_loadu_pd(p.b + i));
+                __m512d scale = _mm512_loadu_pd(p.scale + i);
+                __mmask8 hit;
+                switch (p.kind) {
+                    case SignalPredicate::ABOVE:
+                        hit = _mm512_cmp_pd_mask(diff, _mm512_mul_pd(threshold, scale), _CMP_GT_OQ);
+                        break;
+                    case SignalPredicate::ABS_ABOVE:
+                        hit = _mm512_cmp_pd_mask(_mm512_abs_pd(diff), _mm512_mul_pd(threshold, scale), _CMP_GT_OQ);
+                        break;
+                    default:
+                        hit = _mm512_cmp_pd_mask(_mm512_mul_pd(diff, scale), zero, _CMP_LT_OQ);
+                        break;
+                }
+                bits |= uint64_t(hit) << j;
+            }
+            mask[w] = bits;
+        }
+    }
+#endif
+};
+
+// Screened Strategy - a strategy split into three steps so its trigger can
+// be evaluated for many symbols at once: observe() keeps per-slot columns
+// current (O(1) per tick), predicate() describes the trigger over those
+// columns, and buildOrders() runs only for slots whose trigger fired.
+// generateSignals() chains the three for one symbol.
+class ScreenedStrategy : public TradingStrategy {
+protected:
+    SymbolSlots slots_;
+    size_t lanes_;                          // column length, a multiple of 64
+    std::vector<double> price_, bid_, ask_, ones_;
+    std::vector<uint64_t> touched_;         // slots observed since the last screen()
+
+public:
+    ScreenedStrategy(StrategyType type, size_t max_symbols)
+        : TradingStrategy(type), slots_(max_symbols), lanes_((slots_.capacity() + 63) / 64 * 64),
+          price_(lanes_), bid_(lanes_), ask_(lanes_), ones_(lanes_, 1.0), touched_(lanes_ / 64) {}
+
+    std::vector<Order> generateSignals(const MarketData& data, const OrderBook& orderBook) override {
+        uint16_t slot = observe(data, orderBook);
+        if (slot == SymbolSlots::kNoSlot) return {};
+        touched_[slot >> 6] &= ~(uint64_t(1) << (slot & 63));
+        if (!active_ || !evaluatePredicate(predicate(), slot)) return {};
+        return buildOrders(slot);
+    }
+
+    // Updates the symbol's columns; returns its slot (kNoSlot if full)
+    uint16_t observe(const MarketData& data, const OrderBook& orderBook) {
+        uint16_t slot = slots_.get(data.symbol);
+        if (slot == SymbolSlots::kNoSlot) return slot;
+        onObserve(slot, data);
+        auto [bestBid, bestAsk] = orderBook.getBestBidAsk();
+        price_[slot] = data.price;
+        bid_[slot] = bestBid;
+        ask_[slot] = bestAsk;
+        touched_[slot >> 6] |= uint64_t(1) << (slot & 63);
+        return slot;
+    }
+
+    // Bit per slot that was observed since the last call and whose trigger
+    // fires; returns the number of mask words written
+    size_t screen(uint64_t* mask) {
+        size_t words = touched_.size();
+        SignalKernel::evaluate(predicate(), words, mask);
+        for (size_t w = 0; w < words; ++w) {
+            mask[w] &= touched_[w];
+            touched_[w] = 0;
+        }
+        return words;
+    }
+
+    virtual SignalPredicate predicate() const = 0;
+    virtual std::vector<Order> buildOrders(size_t slot) = 0;
+
+protected:
+    // Strategy-specific state; runs before the common columns take this tick
+    virtual void onObserve(size_t slot, const MarketData& data) = 0;
+
+    Order makeOrder(size_t slot, OrderType side, double price, double quantity) const {
+        return Order(getNextOrderId(), slots_.symbolAt(slot), side, price, quantity, type_);
+    }
+};
+
+// Execution Listener - notified by OrderManager when an order completes
+// or a live order is amended in place
+class ExecutionListener {
+public:
+    virtual ~ExecutionListener() = default;
+    virtual void onFill(const Order& order) = 0;
+    virtual void onCancel(const Order& order) = 0;
+    virtual void onAmend(const Order& /*previous*/, const Order& /*amended*/) {}
+};
+
+// Quote Manager - a strategy's live two-sided quote per symbol slot.
+// update() diffs the wanted quotes against the live ones and returns only
+// the changes: NEW for an empty side, AMEND (same id) when price or size
+// moved, CANCEL when a side is withdrawn, nothing when it is unchanged.
+// Fills and cancels arrive on the OrderManager thread through an SPSC ring
+// and are applied on the strategy's thread by processReports(), so a quote
+// that filled or expired is re-sent as NEW. An AMEND that finds its order
+// gone is cancelled back by OrderManager, which also clears the side here.
+// Deltas the engine refused (risk reject, full order queue) come back
+// through a second ring: a refused NEW clears its side so it is re-sent as
+// NEW, a refused AMEND forgets the price so the next tick amends again.
+// Without tracking (no report feed, e.g. a strategy client process) every
+// quote is sent as NEW and assumed gone once sent.
+class QuoteManager : public ExecutionListener {
+private:
+    struct LiveQuote {
+        uint64_t id;            // 0 = no live quote
+        double price;
+        double quantity;
+    };
+
+    StrategyType type_;
+    const SymbolSlots& slots_;
+    uint64_t (*next_id_)();
+    std::vector<std::array<LiveQuote, 2>> quotes_;   // [slot][BUY, SELL]
+    SpscRing<Order> reports_;
+    SpscRing<Order> refused_;
+    std::atomic<uint64_t> reports_dropped_{0};
+    std::array<std::atomic<uint64_t>, 3> sent_{};    // by OrderAction
+    bool tracking_ = false;
+
+public:
+    QuoteManager(StrategyType type, const SymbolSlots& slots, uint64_t (*next_id)())
+        : type_(type), slots_(slots), next_id_(next_id), quotes_(slots.capacity(), {{}}), reports_(4096),
+          refused_(4096) {}
+
+    // Call once registered with the OrderManager as an ExecutionListener
+    void enableTracking() { tracking_ = true; }
+
+    // OrderManager thread. A dropped report only delays the fix-up: the
+    // next AMEND of that quote is cancelled back.
+    void onFill(const Order& order) override { report(order); }
+    void onCancel(const Order& order) override { report(order); }
+
+    // The thread that submits the engine's orders (one per market data path)
+    void onRefused(const Order& order) {
+        if (!tracking_ || order.strategy != type_ || order.action == OrderAction::CANCEL) return;
+        if (!refused_.push(order)) reports_dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Strategy thread
+    void processReports() {
+        Order report;
+        while (reports_.pop(report)) {
+            if (LiveQuote* live = liveQuote(report)) *live = LiveQuote{};
+        }
+        while (refused_.pop(report)) {
+            LiveQuote* live = liveQuote(report);
+            if (!live) continue;
+            if (report.action == OrderAction::NEW) {
+                *live = LiveQuote{};
+            } else {
+                live->price = 0.0;          // venue still has the pre-AMEND quote
+            }
+        }
+    }
+
+    // A side with quantity <= 0 is withdrawn
+    std::vector<Order> update(size_t slot, double bid, double bid_quantity, double ask, double ask_quantity) {
+        std::vector<Order> deltas;
+        diff(slot, OrderType::BUY, bid, bid_quantity, deltas);
+        diff(slot, OrderType::SELL, ask, ask_quantity, deltas);
+        return deltas;
+    }
+
+    // Price of a side's last quote. With tracking it is the live quote (0
+    // once it filled, was cancelled or was refused as NEW); without tracking
+    // nothing is confirmed and it is the last price requested, so the
+    // market maker still only re-quotes after a tick's move.
+    double livePrice(size_t slot, OrderType side) const { return quotes_[slot][static_cast<size_t>(side)].price; }
+
+    uint64_t sentCount(OrderAction action) const {
+        return sent_[static_cast<size_t>(action)].load(std::memory_order_relaxed);
+    }
+
+    uint64_t droppedReports() const { return reports_dropped_.load(std::memory_order_relaxed); }
+
+private:
+    // The side's live quote if it is still the reported order
+    LiveQuote* liveQuote(const Order& order) {
+        uint16_t slot = slots_.find(order.symbol);
+        if (slot == SymbolSlots::kNoSlot) return nullptr;
+        LiveQuote& live = quotes_[slot][static_cast<size_t>(order.type)];
+        return live.id == order.id ? &live : nullptr;
+    }
+
+    void report(const Order& order) {
+        if (order.strategy != type_) return;
+        if (!reports_.push(order)) reports_dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void diff(size_t slot, OrderType side, double price, double quantity, std::vector<Order>& deltas) {
+        LiveQuote& live = quotes_[slot][static_cast<size_t>(side)];
+        OrderAction action;
+        if (quantity <= 0.0) {
+            if (live.id == 0) return;
+            action = OrderAction::CANCEL;
+            price = live.price;
+            quantity = live.quantity;
+        } else if (live.id == 0) {
+            action = OrderAction::NEW;
+            live.id = next_id_();
+        } else if (live.price == price && live.quantity == quantity) {
+            return;
+        } else {
+            action = OrderAction::AMEND;
+        }
+        deltas.emplace_back(live.id, slots_.symbolAt(slot), side, price, quantity, type_);
+        deltas.back().action = action;
+        if (action == OrderAction::CANCEL) {
+            live = LiveQuote{};
+        } else {
+            live.price = price;
+            live.quantity = quantity;
+            if (!tracking_) live.id = 0;
+        }
+        sent_[static_cast<size_t>(action)].store(sentCount(action) + 1, std::memory_order_relaxed);
+    }
+};
+
+// Position Source - a strategy's net position in a symbol (PnlEngine)
+class PositionSource {
+public:
+    virtual ~PositionSource() = default;
+    virtual double getPosition(StrategyType type, Symbol symbol) const = 0;
+};
+
+// Market making parameters (Avellaneda-Stoikov, time measured in ticks).
+// Prices enter the model in basis points of the symbol's mid, so one set of
+// constants fits BTC/USD at 50000 and ETH/BTC at 0.06 alike.
+struct MarketMakingConfig {
+    bool enabled = true;
+    double risk_aversion = 0.05;         // gamma, per basis point
+    double liquidity = 100.0;            // k: fill intensity decays as e^(-k * distance in bps)
+    double horizon_ticks = 100.0;        // T - t, held constant (rolling horizon)
+    double volatility_halflife = 50.0;   // ticks, EWMA of squared mid changes
+    double quote_size = 10.0;
+    double position_limit = 1000.0;      // no quote that could take |position| past this
+    double tick_size = 0.01;
+};
+
+// Market Making Strategy - Avellaneda-Stoikov quoting. Each tick updates
+// the symbol's variance of mid changes (in bps) and recomputes, in bps of mid,
+//   reservation = mid - q * gamma * sigma^2 * (T - t)
+//   spread      = gamma * sigma^2 * (T - t) + (2 / gamma) * ln(1 + gamma / k)
+// with q the strategy's inventory, then rounds the quotes to the tick and
+// keeps them passive. The log term is constant and computed once, so the
+// per-tick work is a handful of multiplies. Quotes are re-sent only when
+// either side has moved by at least a tick since the last one sent.
+class MarketMakingStrategy : public ScreenedStrategy {
+private:
+    // The config and the constants derived from it, published together
+    struct Params {
+        MarketMakingConfig config;
+        double alpha;                    // EWMA weight of the newest squared change
+        double spread_constant;          // (2 / gamma) * ln(1 + gamma / k)
+
+        explicit Params(const MarketMakingConfig& c = MarketMakingConfig())
+            : config(c), alpha(1.0 - std::exp2(-1.0 / c.volatility_halflife)),
+              spread_constant(2.0 / c.risk_aversion * std::log1p(c.risk_aversion / c.liquidity)) {}
+    };
+
+    LiveParams<Params> params_;
+    const PositionSource* positions_ = nullptr;
+    std::vector<double> mid_, variance_;
+    std::vector<uint32_t> observed_;
+    std::vector<double> tick_, zeros_;
+    std::vector<double> quote_bid_, quote_ask_;
+    std::vector<double> inventory_;
+    std::vector<double> drift_;          // larger move from the live quotes
+    QuoteManager quotes_;
+
+public:
+    MarketMakingStrategy(const MarketMakingConfig& config = MarketMakingConfig(), size_t max_symbols = 1024)
+        : ScreenedStrategy(StrategyType::MARKET_MAKING, max_symbols), params_(Params(config)),
+          mid_(lanes_), variance_(lanes_), observed_(lanes_), tick_(lanes_, config.tick_size), zeros_(lanes_),
+          quote_bid_(lanes_), quote_ask_(lanes_), inventory_(lanes_), drift_(lanes_),
+          quotes_(StrategyType::MARKET_MAKING, slots_, &TradingStrategy::getNextOrderId) {}
+
+    std::string getName() const override { return "Market Making"; }
+
+    void setPositionSource(const PositionSource* positions) { positions_ = positions; }
+
+    QuoteManager& quoteManager() { return quotes_; }
+
+    void onOrderRefused(const Order& order) override { quotes_.onRefused(order); }
+
+    // Operator thread; applies from the next tick. The tick size seeds the
+    // per-symbol tick columns and only changes with a restart.
+    void updateConfig(const MarketMakingConfig& config) {
+        if (config.tick_size != params_.snapshot().config.tick_size) {
+            throw std::invalid_argument("MarketMakingStrategy: tick_size cannot change while running");
+        }
+        params_.publish(Params(config));
+    }
+
+    // Price increment to quote in for a symbol (setup path)
+    void setTickSize(Symbol symbol, double tick_size) {
+        uint16_t slot = slots_.get(symbol);
+        if (slot != SymbolSlots::kNoSlot) tick_[slot] = tick_size;
+    }
+
+    // Re-quote once either side is a tick away from its live quote (moves
+    // are whole ticks; a filled side has no live quote and re-quotes)
+    SignalPredicate predicate() const override {
+        return {SignalPredicate::ABOVE, drift_.data(), zeros_.data(), tick_.data(), 0.5};
+    }
+
+    // Only the sides that changed are sent (see QuoteManager)
+    std::vector<Order> buildOrders(size_t slot) override {
+        drift_[slot] = 0.0;
+        const MarketMakingConfig& config = params_.read().config;
+        const double q = inventory_[slot];
+        double bid_size = std::min(config.quote_size, config.position_limit - q);
+        double ask_size = std::min(config.quote_size, config.position_limit + q);
+        return quotes_.update(slot, quote_bid_[slot], bid_size, quote_ask_[slot], ask_size);
+    }
+
+    double reservationSpread(size_t slot) const { return quote_ask_[slot] - quote_bid_[slot]; }
+
+protected:
+    void onObserve(size_t slot, const MarketData& data) override {
+        quotes_.processReports();
+        if (data.bid <= 0.0 || data.ask <= data.bid) return;
+        const double mid = 0.5 * (data.bid + data.ask);
+        const double change = (mid - mid_[slot]) / mid * kBasisPointsPerUnit;
+        mid_[slot] = mid;
+        if (observed_[slot] < 2) {
+            // First tick has no change; the second seeds the variance
+            if (observed_[slot] == 1) variance_[slot] = change * change;
+            ++observed_[slot];
+            drift_[slot] = 0.0;
+            return;
+        }
+        const Params& params = params_.read();
+        variance_[slot] += params.alpha * (change * change - variance_[slot]);
+
+        const double q = positions_ ? positions_->getPosition(type_, slots_.symbolAt(slot)) : 0.0;
+        inventory_[slot] = q;
+        const double risk = params.config.risk_aversion * variance_[slot] * params.config.horizon_ticks;
+        const double bps = mid / kBasisPointsPerUnit;
+        const double reservation = mid - q * risk * bps;
+        const double half_spread = 0.5 * (risk + params.spread_constant) * bps;
+
+        // Round outward to the tick and never cross the market
+        const double tick = tick_[slot];
+        double bid = std::floor((reservation - half_spread) / tick + 1e-9) * tick;
+        double ask = std::ceil((reservation + half_spread) / tick - 1e-9) * tick;
+        bid = std::min(bid, data.ask - tick);
+        ask = std::max(ask, data.bid + tick);
+        quote_bid_[slot] = bid;
+        quote_ask_[slot] = ask;
+        drift_[slot] = std::max(std::abs(bid - quotes_.livePrice(slot, OrderType::BUY)),
+                                std::abs(ask - quotes_.livePrice(slot, OrderType::SELL)));
+    }
+};
+
+struct ArbitrageConfig {
+    bool enabled = true;
+    double min_profit = 0.05;            // price move since the symbol's previous tick
+    double quantity = 5.0;
+};
+
+// Arbitrage Strategy
+class ArbitrageStrategy : public ScreenedStrategy {
+private:
+    LiveParams<ArbitrageConfig> params_;
+    std::vector<double> last_price_;
+    std::vector<uint8_t> seen_;
+
+public:
+    ArbitrageStrategy(double min_profit = 0.05, double quantity = 5.0, size_t max_symbols = 1024)
+        : ScreenedStrategy(StrategyType::ARBITRAGE, max_symbols),
+          params_(ArbitrageConfig{true, min_profit, quantity}), last_price_(lanes_), seen_(lanes_, 0) {}
+
+    std::string getName() const override { return "Arbitrage"; }
+
+    // Operator thread; applies from the next tick
+    void updateConfig(const ArbitrageConfig& config) { params_.publish(config); }
+
+    // Price moved more than the threshold since the symbol's previous tick
+    SignalPredicate predicate() const override {
+        return {SignalPredicate::ABS_ABOVE, price_.data(), last_price_.data(), ones_.data(),
+                params_.read().min_profit};
+    }
+
+    std::vector<Order> buildOrders(size_t slot) override {
+        // Sell into a rise, buy a drop
+        OrderType side = price_[slot] > last_price_[slot] ? OrderType::SELL : OrderType::BUY;
+        return {makeOrder(slot, side, price_[slot], params_.read().quantity)};
+    }
+
+protected:
+    void onObserve(size_t slot, const MarketData& data) override {
+        last_price_[slot] = seen_[slot] ? price_[slot] : data.price;
+        seen_[slot] = 1;
+    }
+};
+
+struct MomentumConfig {
+    bool enabled = false;
+    size_t fast_period = 10;             // ticks
+    size_t slow_period = 50;             // ticks, also the VWAP window and warmup
+    double quantity = 5.0;
+};
+
+// Momentum Strategy - trades fast/slow EMA crossovers in the direction of
+// the move, confirmed by price being on the same side of the rolling VWAP
+class MomentumStrategy : public ScreenedStrategy {
+private:
+    Ema fast_;
+    Ema slow_;
+    RollingVwap vwap_;
+    std::vector<double> fast_value_, slow_value_, vwap_value_;
+    std::vector<double> previous_trend_;    // 0 until warm
+    std::vector<int8_t> trend_;             // last crossover sign per slot
+    std::vector<uint32_t> ticks_;
+    size_t warmup_;
+    LiveParams<MomentumConfig> params_;
+
+public:
+    MomentumStrategy(size_t fast_period = 10, size_t slow_period = 50, double quantity = 5.0,
+                     size_t max_symbols = 1024)
+        : ScreenedStrategy(StrategyType::MOMENTUM, max_symbols),
+          fast_(lanes_, fast_period), slow_(lanes_, slow_period), vwap_(lanes_, slow_period),
+          fast_value_(lanes_), slow_value_(lanes_), vwap_value_(lanes_), previous_trend_(lanes_),
+          trend_(lanes_, 0), ticks_(lanes_, 0), warmup_(slow_period),
+          params_(MomentumConfig{true, fast_period, slow_period, quantity}) {}
+
+    std::string getName() const override { return "Momentum"; }
+
+    // Operator thread; applies from the next tick. The periods size the
+    // indicator windows and only change with a restart.
+    void updateConfig(const MomentumConfig& config) {
+        MomentumConfig current = params_.snapshot();
+        if (config.fast_period != current.fast_period || config.slow_period != current.slow_period) {
+            throw std::invalid_argument("MomentumStrategy: fast_period and slow_period cannot change while running");
+        }
+        params_.publish(config);
+    }
+
+    // Fast EMA crossed the slow one on this tick
+    SignalPredicate predicate() const override {
+        return {SignalPredicate::SIGN_CHANGE, fast_value_.data(), slow_value_.data(), previous_trend_.data(), 0.0};
+    }
+
+    std::vector<Order> buildOrders(size_t slot) override {
+        double price = price_[slot];
+        double quantity = params_.read().quantity;
+        if (trend_[slot] > 0 && price > vwap_value_[slot]) {
+            return {makeOrder(slot, OrderType::BUY, ask_[slot], quantity)};
+        }
+        if (trend_[slot] < 0 && price < vwap_value_[slot]) {
+            return {makeOrder(slot, OrderType::SELL, bid_[slot], quantity)};
+        }
+        return {};
+    }
+
+protected:
+    // Only runs while the strategy is active: the engine skips inactive
+    // strategies, so the warmup starts when it is first enabled and after a
+    // re-enable the indicators resume from the last tick they saw
+    void onObserve(size_t slot, const MarketData& data) override {
+        double fast = fast_value_[slot] = fast_.update(slot, data.price);
+        double slow = slow_value_[slot] = slow_.update(slot, data.price);
+        vwap_value_[slot] = vwap_.update(slot, data.price, data.volume);
+        if (ticks_[slot] < warmup_) ++ticks_[slot];
+
+        int8_t trend = fast > slow ? 1 : (fast < slow ? -1 : 0);
+        previous_trend_[slot] = ticks_[slot] < warmup_ ? 0.0 : trend_[slot];
+        trend_[slot] = trend;
+    }
+};
+
+struct MeanReversionConfig {
+    bool enabled = false;
+    size_t window = 100;                 // ticks
+    double entry_z = 2.0;
+    double exit_z = 0.5;
+    double quantity = 5.0;
+};
+
+// Mean Reversion Strategy - fades moves more than entry_z standard
+// deviations from the rolling mean; re-arms once the z-score is back
+// inside exit_z so one excursion produces one order
+class MeanReversionStrategy : public ScreenedStrategy {
+private:
+    RollingStats stats_;
+    std::vector<double> mean_;              // window mean before this tick
+    std::vector<double> scale_;             // stddev while armed, infinity otherwise
+    std::vector<uint8_t> armed_;
+    LiveParams<MeanReversionConfig> params_;
+
+public:
+    MeanReversionStrategy(size_t window = 100, double entry_z = 2.0, double exit_z = 0.5,
+                          double quantity = 5.0, size_t max_symbols = 1024)
+        : ScreenedStrategy(StrategyType::MEAN_REVERSION, max_symbols),
+          stats_(lanes_, window), mean_(lanes_), scale_(lanes_, HUGE_VAL), armed_(lanes_, 1),
+          params_(MeanReversionConfig{true, window, entry_z, exit_z, quantity}) {}
+
+    std::string getName() const override { return "Mean Reversion"; }
+
+    // Operator thread; applies from the next tick. The window sizes the
+    // rolling statistics and only changes with a restart.
+    void updateConfig(const MeanReversionConfig& config) {
+        if (config.window != params_.snapshot().window) {
+            throw std::invalid_argument("MeanReversionStrategy: window cannot change while running");
+        }
+        params_.publish(config);
+    }
+
+    // |price - mean| > entry_z * stddev, i.e. |z| > entry_z
+    SignalPredicate predicate() const override {
+        return {SignalPredicate::ABS_ABOVE, price_.data(), mean_.data(), scale_.data(), params_.read().entry_z};
+    }
+
+    std::vector<Order> buildOrders(size_t slot) override {
+        armed_[slot] = 0;
+        scale_[slot] = HUGE_VAL;
+        double quantity = params_.read().quantity;
+        if (price_[slot] > mean_[slot]) {
+            return {makeOrder(slot, OrderType::SELL, ask_[slot], quantity)};
+        }
+        return {makeOrder(slot, OrderType::BUY, bid_[slot], quantity)};
+    }
+
+protected:
+    // Score against the window before this tick joins it
+    void onObserve(size_t slot, const MarketData& data) override {
+        bool ready = stats_.full(slot);
+        double z = stats_.zscore(slot, data.price);
+        double sd = stats_.stddev(slot);
+        mean_[slot] = stats_.mean(slot);
+        stats_.update(slot, data.price);
+
+        if (ready && std::abs(z) < params_.read().exit_z) armed_[slot] = 1;
+        scale_[slot] = ready && armed_[slot] && sd > 0.0 ? sd : HUGE_VAL;
+    }
+};
+
+// Venue Tournament - winner tree over the venues: a leaf per venue holds its
+// quote and every internal node the venue winning its subtree, so the root
+// is the best venue and an update replays one leaf-to-root path, O(log venues)
+template<typename Better>
+class VenueTournament {
+private:
+    std::array<double, kMaxVenues> value_;
+    std::array<VenueId, kMaxVenues> winner_;   // node k has children 2k, 2k+1; root is 1
+
+    VenueId winnerOf(size_t node) const {
+        return node >= kMaxVenues ? static_cast<VenueId>(node - kMaxVenues) : winner_[node];
+    }
+
+public:
+    explicit VenueTournament(double empty) {
+        value_.fill(empty);
+        for (size_t node = kMaxVenues - 1; node >= 1; --node) winner_[node] = winnerOf(2 * node);
+    }
+
+    void update(VenueId venue, double value) {
+        value_[venue] = value;
+        for (size_t node = (kMaxVenues + venue) / 2; node >= 1; node /= 2) {
+            VenueId left = winnerOf(2 * node);
+            VenueId right = winnerOf(2 * node + 1);
+            winner_[node] = Better()(value_[right], value_[left]) ? right : left;
+        }
+    }
+
+    VenueId best() const { return winner_[1]; }
+    double bestValue() const { return value_[winner_[1]]; }
+    double value(VenueId venue) const { return value_[venue]; }
+};
+
+struct CrossVenueConfig {
+    bool enabled = true;                 // only runs with more than one venue
+    double min_edge = 0.5;               // best bid - best ask across venues
+    double max_quantity = 5.0;
+};
+
+// Cross-Venue Arbitrage - keeps a bid tournament and an ask tournament per
+// symbol over every venue's top of book. Each tick replays its venue's leaves
+// and compares the two roots, so a dislocation is seen on the tick that
+// causes it. Fires a buy on the cheapest venue and a sell on the richest
+// when they cross by more than min_edge, then waits for the cross to close
+// before re-arming so one dislocation yields one pair.
+class CrossVenueArbitrageStrategy : public TradingStrategy {
+private:
+    SymbolSlots slots_;
+    std::vector<VenueTournament<std::greater<double>>> bids_;
+    std::vector<VenueTournament<std::less<double>>> asks_;
+    std::vector<double> bid_quantity_;     // [slot * kMaxVenues + venue]
+    std::vector<double> ask_quantity_;
+    std::vector<uint8_t> armed_;
+    LiveParams<CrossVenueConfig> params_;
+    std::atomic<uint64_t> detections_{0};
+
+public:
+    CrossVenueArbitrageStrategy(double min_edge = 0.5, double max_quantity = 5.0, size_t max_symbols = 64)
+        : TradingStrategy(StrategyType::CROSS_VENUE_ARBITRAGE), slots_(max_symbols),
+          bids_(slots_.capacity(), VenueTournament<std::greater<double>>(-HUGE_VAL)),
+          asks_(slots_.capacity(), VenueTournament<std::less<double>>(HUGE_VAL)),
+          bid_quantity_(slots_.capacity() * kMaxVenues), ask_quantity_(slots_.capacity() * kMaxVenues),
+          armed_(slots_.capacity(), 1), params_(CrossVenueConfig{true, min_edge, max_quantity}) {}
+
+    std::string getName() const override { return "Cross-Venue Arb"; }
+    bool handlesVenue(VenueId) const override { return true; }
+
+    // Operator thread; applies from the next tick
+    void updateConfig(const CrossVenueConfig& config) { params_.publish(config); }
+
+    // `orderBook` is the book of the tick's venue
+    std::vector<Order> generateSignals(const MarketData& data, const OrderBook& orderBook) override {
+        uint16_t slot = slots_.get(data.symbol);
+        if (slot == SymbolSlots::kNoSlot) return {};
+
+        TopOfBook top = orderBook.getTopOfBook();
+        size_t cell = slot * kMaxVenues + data.venue;
+        bid_quantity_[cell] = top.bid_quantity;
+        ask_quantity_[cell] = top.ask_quantity;
+        bids_[slot].update(data.venue, top.bid_quantity > 0.0 ? top.bid : -HUGE_VAL);
+        asks_[slot].update(data.venue, top.ask_quantity > 0.0 ? top.ask : HUGE_VAL);
+
+        // Each venue's own book is uncrossed, so a cross spans two venues
+        double edge = bids_[slot].bestValue() - asks_[slot].bestValue();
+        if (edge <= 0.0) {
+            armed_[slot] = 1;
+            return {};
+        }
+        const CrossVenueConfig& params = params_.read();
+        if (edge <= params.min_edge || !armed_[slot]) return {};
+        armed_[slot] = 0;
+        detections_.fetch_add(1, std::memory_order_relaxed);
+
+        VenueId sell_venue = bids_[slot].best();
+        VenueId buy_venue = asks_[slot].best();
+        double quantity = std::min({params.max_quantity, bid_quantity_[slot * kMaxVenues + sell_venue],
+                                    ask_quantity_[slot * kMaxVenues + buy_venue]});
+        Order buy(getNextOrderId(), data.symbol, OrderType::BUY, asks_[slot].bestValue(), quantity, type_);
+        Order sell(getNextOrderId(), data.symbol, OrderType::SELL, bids_[slot].bestValue(), quantity, type_);
+        buy.venue = buy_venue;
+        sell.venue = sell_venue;
+        return {buy, sell};
+    }
+
+    uint64_t getDetectionCount() const { return detections_.load(std::memory_order_relaxed); }
+};
+
+struct TriangularConfig {
+    bool enabled = true;                 // only runs if the symbols form a cycle
+    double min_return = 0.00005;         // per pass through a cycle
+    double quantity = 1.0;               // base units on the first leg
+    size_t max_cycle_length = 3;
+};
+
+// Triangular Arbitrage - a graph with a node per currency and, for every
+// BASE/QUOTE symbol, an edge BASE->QUOTE weighted log(bid) (sell the base)
+// and QUOTE->BASE weighted -log(ask) (buy it). A cycle whose weights sum
+// above zero turns one unit of its start currency into more than one.
+// All simple cycles up to max_cycle_length are enumerated at construction
+// and indexed by edge, so a tick re-evaluates only the cycles through its
+// symbol's two edges. Cycles re-arm once they stop being profitable.
+class TriangularArbitrageStrategy : public TradingStrategy {
+public:
+    static constexpr size_t kMaxLegs = 8;
+
+private:
+    struct Edge {
+        uint16_t from;
+        uint16_t to;
+        uint16_t symbol;          // index into symbols_
+        OrderType side;           // SELL from base to quote, BUY from quote to base
+    };
+
+    struct Cycle {
+        std::vector<uint32_t> edges;
+        uint8_t armed;
+    };
+
+    struct Params {
+        TriangularConfig config;
+        double min_edge;                           // required log return
+
+        explicit Params(const TriangularConfig& c = TriangularConfig())
+            : config(c), min_edge(std::log1p(c.min_return)) {}
+    };
+
+    SymbolSlots slots_;                            // symbol -> index into symbols_
+    std::vector<Symbol> symbols_;
+    std::vector<Edge> edges_;                      // edges 2k (sell) and 2k+1 (buy) belong to symbol k
+    std::vector<double> weight_;
+    std::vector<double> price_;                    // bid for sell edges, ask for buy edges
+    std::vector<double> depth_;                    // top-of-book size behind each edge
+    std::vector<Cycle> cycles_;
+    std::vector<std::vector<uint32_t>> cycles_by_edge_;
+    LiveParams<Params> params_;
+    std::atomic<uint64_t> detections_{0};
+
+public:
+    TriangularArbitrageStrategy(const std::vector<std::string>& symbols, double min_return = 0.00005,
+                                double quantity = 1.0, size_t max_cycle_length = 3)
+        : TradingStrategy(StrategyType::TRIANGULAR_ARBITRAGE), slots_(symbols.size()),
+          params_(Params(TriangularConfig{true, min_return, quantity, max_cycle_length})) {
+        std::vector<std::string> currencies;
+        auto node = [&currencies](const std::string& currency) {
+            auto it = std::find(currencies.begin(), currencies.end(), currency);
+            if (it != currencies.end()) return static_cast<uint16_t>(it - currencies.begin());
+            currencies.push_back(currency);
+            return static_cast<uint16_t>(currencies.size() - 1);
+        };
+        for (const auto& name : symbols) {
+            size_t slash = name.find('/');
+            if (slash == std::string::npos) continue;     // not a currency pair
+            Symbol symbol(name);
+            if (slots_.get(symbol) != symbols_.size()) continue;    // duplicate
+            uint16_t base = node(name.substr(0, slash));
+            uint16_t quote = node(name.substr(slash + 1));
+            uint16_t index = static_cast<uint16_t>(symbols_.size());
+            symbols_.push_back(symbol);
+            edges_.push_back({base, quote, index, OrderType::SELL});
+            edges_.push_back({quote, base, index, OrderType::BUY});
+        }
+        weight_.assign(edges_.size(), -HUGE_VAL);
+        price_.assign(edges_.size(), 0.0);
+        depth_.assign(edges_.size(), 0.0);
+        cycles_by_edge_.resize(edges_.size());
+        enumerateCycles(currencies.size(), std::min(max_cycle_length, kMaxLegs));
+    }
+
+    std::string getName() const override { return "Triangular Arb"; }
+
+    // Operator thread; applies from the next tick. Cycles are enumerated at
+    // construction, so max_cycle_length only changes with a restart.
+    void updateConfig(const TriangularConfig& config) {
+        if (config.max_cycle_length != params_.snapshot().config.max_cycle_length) {
+            throw std::invalid_argument("TriangularArbitrageStrategy: max_cycle_length cannot change while running");
+        }
+        params_.publish(Params(config));
+    }
+
+    std::vector<Order> generateSignals(const MarketData& data, const OrderBook& orderBook) override {
+        uint16_t index = slots_.get(data.symbol);
+        if (index == SymbolSlots::kNoSlot || index >= symbols_.size()) return {};
+
+        TopOfBook top = orderBook.getTopOfBook();
+        const uint32_t sell = 2 * index, buy = sell + 1;
+        bool quoted = top.bid > 0.0 && top.ask > 0.0 && top.bid_quantity > 0.0 && top.ask_quantity > 0.0;
+        weight_[sell] = quoted ? std::log(top.bid) : -HUGE_VAL;
+        weight_[buy] = quoted ? -std::log(top.ask) : -HUGE_VAL;
+        price_[sell] = top.bid;
+        price_[buy] = top.ask;
+        depth_[sell] = top.bid_quantity;
+        depth_[buy] = top.ask_quantity;
+
+        const Params& params = params_.read();
+        std::vector<Order> orders;
+        for (uint32_t edge : {sell, buy}) {
+            for (uint32_t c : cycles_by_edge_[edge]) {
+                Cycle& cycle = cycles_[c];
+                double log_return = 0.0;
+                for (uint32_t e : cycle.edges) log_return += weight_[e];
+                if (log_return <= 0.0) {
+                    cycle.armed = 1;
+                } else if (log_return > params.min_edge && cycle.armed) {
+                    cycle.armed = 0;
+                    detections_.fetch_add(1, std::memory_order_relaxed);
+                    buildLegs(cycle, params.config.quantity, orders);
+                }
+            }
+        }
+        return orders;
+    }
+
+    size_t cycleCount() const { return cycles_.size(); }
+    uint64_t getDetectionCount() const { return detections_.load(std::memory_order_relaxed); }
+
+private:
+    // Depth-first from each start node through higher-numbered nodes only,
+    // so every directed cycle is found once, from its lowest node
+    void enumerateCycles(size_t nodes, size_t max_length) {
+        std::vector<std::vector<uint32_t>> out(nodes);
+        for (uint32_t e = 0; e < edges_.size(); ++e) out[edges_[e].from].push_back(e);
+
+        std::vector<uint32_t> path;
+        std::vector<uint8_t> on_path(nodes, 0);
+        std::function<void(uint16_t, uint16_t)> extend = [&](uint16_t start, uint16_t at) {
+            for (uint32_t e : out[at]) {
+                uint16_t to = edges_[e].to;
+                if (to == start && path.size() + 1 >= 3) {
+                    path.push_back(e);
+                    cycles_.push_back({path, 1});
+                    path.pop_back();
+                } else if (to > start && !on_path[to] && path.size() + 1 < max_length) {
+                    on_path[to] = 1;
+                    path.push_back(e);
+                    extend(start, to);
+                    path.pop_back();
+                    on_path[to] = 0;
+                }
+            }
+        };
+        for (uint16_t start = 0; start < nodes; ++start) {
+            on_path[start] = 1;
+            extend(start, start);
+            on_path[start] = 0;
+        }
+        for (uint32_t c = 0; c < cycles_.size(); ++c) {
+            for (uint32_t e : cycles_[c].edges) cycles_by_edge_[e].push_back(c);
+        }
+    }
+
+    // Sizes the legs so each consumes what the previous one produced, starting
+    // from `base_quantity` units on the first leg, scaled down to fit the
+    // top-of-book size of every leg
+    void buildLegs(const Cycle& cycle, double base_quantity, std::vector<Order>& orders) {
+        const Edge& first = edges_[cycle.edges.front()];
+        double amount = first.side == OrderType::SELL ? base_quantity
+                                                      : base_quantity * price_[cycle.edges.front()];
+        double scale = 1.0;
+        std::array<double, kMaxLegs> quantity{};
+        for (size_t leg = 0; leg < cycle.edges.size(); ++leg) {
+            uint32_t e = cycle.edges[leg];
+            quantity[leg] = edges_[e].side == OrderType::SELL ? amount : amount / price_[e];
+            amount = edges_[e].side == OrderType::SELL ? amount * price_[e] : quantity[leg];
+            scale = std::min(scale, depth_[e] / quantity[leg]);
+        }
+        for (size_t leg = 0; leg < cycle.edges.size(); ++leg) {
+            const Edge& edge = edges_[cycle.edges[leg]];
+            orders.emplace_back(getNextOrderId(), symbols_[edge.symbol], edge.side,
+                                price_[cycle.edges[leg]], quantity[leg] * scale, type_);
+        }
+    }
+};
+
+// Plugin Library - a dlopen'd strategy plugin and the factories its
+// hft_plugin_init registered. The file is copied to a private path before
+// loading so a rebuilt library at the same path is loaded afresh instead of
+// glibc handing back the already-mapped old version.
+class PluginLibrary {
+private:
+    std::shared_ptr<void> handle_;
+    std::vector<const hft_strategy_factory*> factories_;
+
+    static const char* symbolName(uint16_t symbol) {
+        return symbol < SymbolTable::instance().size() ? Symbol(symbol).str().c_str() : "";
+    }
+
+    static void registerFactory(void* registry, const hft_strategy_factory* factory) {
+        static_cast<PluginLibrary*>(registry)->factories_.push_back(factory);
+    }
+
+    static std::string privateCopy(const std::string& path) {
+        int in = ::open(path.c_str(), O_RDONLY);
+        if (in < 0) throw std::runtime_error("PluginLibrary: cannot open " + path + ": " + std::strerror(errno));
+        char copy[] = "/tmp/hft_plugin_XXXXXX";
+        int out = ::mkstemp(copy);
+        if (out < 0) {
+            ::close(in);
+            throw std::runtime_error(std::string("PluginLibrary: mkstemp: ") + std::strerror(errno));
+        }
+        char buffer[65536];
+        ssize_t n;
+        bool ok = true;
+        while (ok && (n = ::read(in, buffer, sizeof(buffer))) > 0) {
+            ok = ::write(out, buffer, static_cast<size_t>(n)) == n;
+        }
+        ok = ok && n == 0;
+        ::close(in);
+        ::close(out);
+        if (!ok) {
+            ::unlink(copy);
+            throw std::runtime_error("PluginLibrary: cannot copy " + path);
+        }
+        return copy;
+    }
+
+public:
+    explicit PluginLibrary(const std::string& path) {
+        std::string copy = privateCopy(path);
+        void* handle = ::dlopen(copy.c_str(), RTLD_NOW | RTLD_LOCAL);
+        ::unlink(copy.c_str());     // the mapping stays valid until dlclose
+        if (!handle) throw std::runtime_error(std::string("PluginLibrary: ") + ::dlerror());
+        handle_ = std::shared_ptr<void>(handle, [](void* h) { ::dlclose(h); });
+
+        auto init = reinterpret_cast<hft_plugin_init_fn>(::dlsym(handle, HFT_PLUGIN_INIT_SYMBOL));
+        if (!init) throw std::runtime_error("PluginLibrary: " + path + " does not export " HFT_PLUGIN_INIT_SYMBOL);
+        static const hft_host host{HFT_PLUGIN_ABI_VERSION, &PluginLibrary::symbolName};
+        if (init(&host, &PluginLibrary::registerFactory, this) != 0) {
+            throw std::runtime_error("PluginLibrary: " + path + " failed to initialize");
+        }
+        for (const auto* factory : factories_) {
+            if (!factory || !factory->name || !factory->create || !factory->destroy || !factory->on_tick) {
+                throw std::runtime_error("PluginLibrary: " + path + " registered an incomplete factory");
+            }
+        }
+        if (factories_.empty()) throw std::runtime_error("PluginLibrary: " + path + " registered no strategies");
+    }
+
+    const std::shared_ptr<void>& handle() const { return handle_; }
+    const std::vector<const hft_strategy_factory*>& factories() const { return factories_; }
+};
+
+// Plugin Strategy - hosts the strategies deployed from plugin libraries.
+// Loading (dlopen, init) happens on the operator's thread; the result is
+// staged and swapped in by the strategy thread at the start of its next
+// tick, so a tick never sees a half-deployed set. A redeployed strategy is
+// created from the state its predecessor saved, and the old library is
+// unloaded once its last instance is destroyed. Plugins see lead venue
+// ticks and their fills are booked under StrategyType::PLUGIN.
+class PluginStrategy : public TradingStrategy {
+public:
+    static constexpr size_t kMaxOrdersPerTick = 8;
+
+private:
+    struct Instance {
+        std::shared_ptr<void> library;     // keeps the code mapped while the instance lives
+        const hft_strategy_factory* factory;
+        void* self;
+    };
+
+    struct Deployment {
+        std::shared_ptr<void> library;
+        const hft_strategy_factory* factory;
+        std::string config;                // empty to undeploy factory->name
+        std::string name;
+        std::chrono::steady_clock::time_point staged;
+    };
+
+    std::vector<Instance> instances_;                   // strategy thread only
+    std::atomic<bool> pending_{false};
+    std::mutex mutex_;                                  // guards staged_
+    std::vector<Deployment> staged_;
+    LiveParams<std::vector<std::string>> names_;        // published by applyStaged
+    std::atomic<uint64_t> swaps_{0};
+    std::atomic<uint64_t> failed_{0};
+    std::atomic<uint64_t> rejected_orders_{0};
+    std::atomic<double> last_swap_us_{0.0};             // staged to live, includes state handoff
+
+public:
+    PluginStrategy() : TradingStrategy(StrategyType::PLUGIN) { active_ = false; }
+
+    ~PluginStrategy() override {
+        for (auto& instance : instances_) instance.factory->destroy(instance.self);
+    }
+
+    std::string getName() const override { return "Plugins"; }
+
+    // Operator thread: stages every factory of `library` for deployment
+    void deploy(const PluginLibrary& library, const std::string& config) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto* factory : library.factories()) {
+            staged_.push_back({library.handle(), factory, config, factory->name, std::chrono::steady_clock::now()});
+        }
+        pending_.store(true, std::memory_order_release);
+    }
+
+    void undeploy(const std::string& name) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        staged_.push_back({nullptr, nullptr, std::string(), name, std::chrono::steady_clock::now()});
+        pending_.store(true, std::memory_order_release);
+    }
+
+    std::vector<Order> generateSignals(const MarketData& data, const OrderBook& orderBook) override {
+        if (pending_.load(std::memory_order_acquire)) applyStaged();
+        if (instances_.empty()) return {};
+
+        TopOfBook book = orderBook.getTopOfBook();
+        const hft_tick tick{data.symbol.id(), data.venue, data.price, data.volume, data.bid, data.ask};
+        const hft_top top{book.bid, book.bid_quantity, book.ask, book.ask_quantity};
+        std::array<hft_order, kMaxOrdersPerTick> out;
+        std::vector<Order> orders;
+        for (auto& instance : instances_) {
+            size_t count = std::min(instance.factory->on_tick(instance.self, &tick, &top, out.data(), out.size()),
+                                    out.size());
+            for (size_t i = 0; i < count; ++i) {
+                const hft_order& o = out[i];
+                if (o.side > HFT_SIDE_SELL || o.venue >= kMaxVenues || o.symbol >= SymbolTable::instance().size() ||
+                    !(o.price > 0.0) || !(o.quantity > 0.0) || !std::isfinite(o.price) || !std::isfinite(o.quantity)) {
+                    rejected_orders_.fetch_add(1, std::memory_order_relaxed);
+                    continue;
+                }
+                Order order(getNextOrderId(), Symbol(o.symbol), o.side == HFT_SIDE_BUY ? OrderType::BUY : OrderType::SELL,
+                            o.price, o.quantity, type_);
+                order.venue = o.venue;
+                orders.push_back(order);
+            }
+        }
+        return orders;
+    }
+
+    // Only valid inside an EpochGuard
+    const std::vector<std::string>& deployedNames() const { return names_.read(); }
+    uint64_t swapCount() const { return swaps_.load(std::memory_order_relaxed); }
+    uint64_t failedCount() const { return failed_.load(std::memory_order_relaxed); }
+    uint64_t rejectedOrderCount() const { return rejected_orders_.load(std::memory_order_relaxed); }
+    double lastSwapMicros() const { return last_swap_us_.load(std::memory_order_relaxed); }
+
+private:
+    // Strategy thread, at a tick boundary
+    void applyStaged() {
+        std::vector<Deployment> staged;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            staged.swap(staged_);
+            pending_.store(false, std::memory_order_relaxed);
+        }
+        for (auto& deployment : staged) {
+            auto it = std::find_if(instances_.begin(), instances_.end(), [&](const Instance& instance) {
+                return deployment.name == instance.factory->name;
+            });
+            if (!deployment.factory) {
+                if (it != instances_.end()) {
+                    it->factory->destroy(it->self);
+                    instances_.erase(it);
+                }
+            } else if (swapIn(deployment, it)) {
+                swaps_.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                failed_.fetch_add(1, std::memory_order_relaxed);
+            }
+            last_swap_us_.store(std::chrono::duration<double, std::micro>(
+                std::chrono::steady_clock::now() - deployment.staged).count(), std::memory_order_relaxed);
+        }
+        std::vector<std::string> names;
+        for (const auto& instance : instances_) names.push_back(instance.factory->name);
+        names_.publish(names);
+    }
+
+    // Creates the new instance from the old one's saved state; the old one
+    // stays live if the new one cannot be created
+    bool swapIn(const Deployment& deployment, std::vector<Instance>::iterator previous) {
+        std::vector<unsigned char> state;
+        if (previous != instances_.end() && previous->factory->save_state) {
+            size_t size = previous->factory->save_state(previous->self, nullptr, 0);
+            state.resize(size);
+            if (size && previous->factory->save_state(previous->self, state.data(), size) != size) state.clear();
+        }
+        void* self = deployment.factory->create(deployment.config.c_str(), state.empty() ? nullptr : state.data(),
+                                                state.size());
+        if (!self) return false;
+        Instance instance{deployment.library, deployment.factory, self};
+        if (previous != instances_.end()) {
+            previous->factory->destroy(previous->self);
+            *previous = std::move(instance);
+        } else {
+            instances_.push_back(std::move(instance));
+        }
+        return true;
+    }
+};
+
+// P&L Engine - realized and mark-to-market P&L from actual fills.
+// Fills arrive on the OrderManager thread and are handed to the engine
+// thread through an SPSC ring; the engine thread is the only writer of the
+// per-strategy, per-symbol positions (average-cost method) and re-marks
+// them on every top-of-book change. Both updates are O(1) per event (a
+// mark touches one cell per strategy type), and the totals are published
+// in atomics so RiskManager and the UI read them without locks. Each
+// symbol's P&L is in its quote currency and the totals add them unconverted
+// (a BTC-quoted cross counts its BTC P&L as if it were USD).
+class PnlEngine : public ExecutionListener, public PositionSource {
+private:
+    static constexpr size_t kCells = kNumStrategyTypes * SymbolTable::kMaxSymbols;
+
+    struct alignas(64) StrategyTotals {
+        std::atomic<double> realized{0.0};
+        std::atomic<double> unrealized{0.0};
+        std::atomic<uint64_t> fills{0};
+    };
+
+    SpscRing<Order> fills_;
+    std::atomic<uint64_t> fills_dropped_{0};
+
+    // Engine-thread state, indexed [strategy * kMaxSymbols + symbol]
+    std::vector<std::atomic<double>> position_;
+    std::vector<double> average_cost_;
+    std::vector<double> mark_;                       // per symbol
+    std::array<StrategyTotals, kNumStrategyTypes> totals_;
+
+public:
+    PnlEngine() : fills_(65536), position_(kCells), average_cost_(kCells, 0.0),
+                  mark_(SymbolTable::kMaxSymbols, 0.0) {}
+
+    // OrderManager thread
+    void onFill(const Order& order) override {
+        for (int attempt = 0; !fills_.push(order); ++attempt) {
+            if (attempt == 1000) {
+                // Engine thread is gone (shutdown); don't wedge the order thread
+                fills_dropped_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            std::this_thread::yield();
+        }
+    }
+
+    void onCancel(const Order&) override {}
+
+    // Engine thread: applies every fill received so far
+    void processFills() {
+        Order fill;
+        while (fills_.pop(fill)) {
+            applyFill(fill);
+        }
+    }
+
+    // Engine thread: re-marks every strategy's position in this symbol
+    void onTopOfBook(Symbol symbol, double bid, double ask) {
+        if (bid <= 0.0 || ask <= 0.0) return;
+        const double mark = 0.5 * (bid + ask);
+        const double move = mark - mark_[symbol.id()];
+        if (move == 0.0) return;
+        mark_[symbol.id()] = mark;
+        for (size_t st = 0; st < kNumStrategyTypes; ++st) {
+            double position = position_[cell(st, symbol.id())].load(std::memory_order_relaxed);
+            if (position != 0.0) addTo(totals_[st].unrealized, position * move);
+        }
+    }
+
+    double getRealizedPnL(StrategyType type) const {
+        return totals_[static_cast<size_t>(type)].realized.load(std::memory_order_relaxed);
+    }
+
+    double getUnrealizedPnL(StrategyType type) const {
+        return totals_[static_cast<size_t>(type)].unrealized.load(std::memory_order_relaxed);
+    }
+
+    double getStrategyPnL(StrategyType type) const { return getRealizedPnL(type) + getUnrealizedPnL(type); }
+
+    uint64_t getFillCount(StrategyType type) const {
+        return totals_[static_cast<size_t>(type)].fills.load(std::memory_order_relaxed);
+    }
+
+    double getTotalPnL() const {
+        double total = 0.0;
+        for (size_t st = 0; st < kNumStrategyTypes; ++st) total += getStrategyPnL(static_cast<StrategyType>(st));
+        return total;
+    }
+
+    double getPosition(StrategyType type, Symbol symbol) const override {
+        return position_[cell(static_cast<size_t>(type), symbol.id())].load(std::memory_order_relaxed);
+    }
+
+private:
+    static size_t cell(size_t strategy, SymbolId symbol) { return strategy * SymbolTable::kMaxSymbols + symbol; }
+
+    // Single writer, so a plain load/store replaces the RMW
+    static void addTo(std::atomic<double>& value, double delta) {
+        value.store(value.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+    }
+
+    void applyFill(const Order& fill) {
+        const size_t st = static_cast<size_t>(fill.strategy);
+        const size_t c = cell(st, fill.symbol.id());
+        // Before the first top of book the fill price stands in as the mark;
+        // a zero mark would value the position as a total loss
+        double& symbol_mark = mark_[fill.symbol.id()];
+        if (symbol_mark == 0.0) symbol_mark = fill.price;
+        const double mark = symbol_mark;
+        const double quantity = fill.type == OrderType::BUY ? fill.quantity : -fill.quantity;
+
+        double position = position_[c].load(std::memory_order_relaxed);
+        double& average = average_cost_[c];
+        const double unrealized_before = position * (mark - average);
+        double realized = 0.0;
+
+        if (position == 0.0 || (position > 0.0) == (quantity > 0.0)) {
+            // Opening or adding: blend into the average cost
+            average = (average * std::abs(position) + fill.price * std::abs(quantity)) /
+                      (std::abs(position) + std::abs(quantity));
+            position += quantity;
+        } else {
+            // Reducing, closing or flipping: realize against the average cost
+            const double closed = std::min(std::abs(quantity), std::abs(position));
+            realized = closed * (fill.price - average) * (position > 0.0 ? 1.0 : -1.0);
+            position += quantity;
+            if (position == 0.0) {
+                average = 0.0;
+            } else if ((position > 0.0) != (quantity < 0.0)) {
+                average = fill.price;  // flipped through flat; remainder opened at fill price
+            }
+        }
+
+        position_[c].store(position, std::memory_order_relaxed);
+        StrategyTotals& totals = totals_[st];
+        addTo(totals.realized, realized);
+        addTo(totals.unrealized, position * (mark - average) - unrealized_before);
+        totals.fills.store(totals.fills.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+};
+
+// TSC Clock - cycle-counter timestamps (no syscall), calibrated once
+// against steady_clock; falls back to steady_clock on other architectures
+class TscClock {
+public:
+    static uint64_t now() {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+    }
+
+    static double ticksPerSecond() {
+        static const double rate = calibrate();
+        return rate;
+    }
+
+    static uint64_t fromSeconds(double seconds) {
+        return static_cast<uint64_t>(seconds * ticksPerSecond());
+    }
+
+private:
+    static double calibrate() {
+#if defined(__x86_64__) || defined(__i386__)
+        auto wall_start = std::chrono::steady_clock::now();
+        uint64_t tsc_start = now();
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        uint64_t tsc_end = now();
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+        return (tsc_end - tsc_start) / elapsed;
+#else
+        return static_cast<double>(std::chrono::steady_clock::period::den) /
+               std::chrono::steady_clock::period::num;
+#endif
+    }
+};
+
+// Token Bucket - lock-free rate limiter in GCRA form: one atomic holds the
+// theoretical arrival time of the next token, so a check is a single CAS
+class TokenBucket {
+private:
+    std::atomic<uint64_t> tat_{0};
+    std::atomic<uint64_t> interval_{0};     // TSC ticks per token (0 = unlimited)
+    std::atomic<uint64_t> tolerance_{0};    // how far ahead tat may run (burst - 1 tokens)
+
+public:
+    // Rate <= 0 disables the limit. Safe while trading: a check racing the
+    // change may pair the old interval with the new tolerance once.
+    void configure(double rate, double burst) {
+        if (rate <= 0.0) {
+            interval_.store(0, std::memory_order_relaxed);
+            return;
+        }
+        uint64_t interval = std::max<uint64_t>(1, static_cast<uint64_t>(TscClock::ticksPerSecond() / rate));
+        tolerance_.store(static_cast<uint64_t>(std::max(0.0, burst - 1.0) * interval), std::memory_order_relaxed);
+        interval_.store(interval, std::memory_order_relaxed);
+    }
+
+    bool tryAcquire(uint64_t now) {
+        const uint64_t interval = interval_.load(std::memory_order_relaxed);
+        if (interval == 0) return true;
+        const uint64_t tolerance = tolerance_.load(std::memory_order_relaxed);
+        uint64_t tat = tat_.load(std::memory_order_relaxed);
+        while (true) {
+            uint64_t base = std::max(tat, now);
+            if (base - now > tolerance) return false;
+            if (tat_.compare_exchange_weak(tat, base + interval, std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+    }
+
+    // Gives back a token taken for an order that was rejected afterwards
+    void refund() {
+        const uint64_t interval = interval_.load(std::memory_order_relaxed);
+        if (interval != 0) tat_.fetch_sub(interval, std::memory_order_relaxed);
+    }
+};
+
+// Pre-trade risk limits; per-symbol and per-strategy values are defaults
+// that RiskManager::setSymbolLimits / setStrategyLimits can override.
+// RiskManager::updateLimits replaces them while trading. Notional is price
+// times quantity in each symbol's quote currency and is summed without
+// conversion, so with a cross such as ETH/BTC (BTC-quoted) next to USD pairs
+// the notional totals are mixed-currency and the limits are nominal.
+struct RiskLimits {
+    double max_position = 10000.0;            // net shares across everything
+    double daily_loss_limit = -5000.0;
+    double max_order_quantity = 1000.0;
+    double price_band = 0.05;                 // max |price - mid| / mid
+    double max_net_notional = 1e9;            // signed notional of position + in-flight, per side
+    double max_gross_notional = 1e8;          // notional of all in-flight orders
+    double symbol_max_position = 10000.0;
+    double strategy_max_position = 10000.0;
+    double strategy_order_rate = 5000.0;      // token bucket, orders/second (0 = unlimited)
+    double strategy_order_burst = 100.0;
+    double symbol_order_rate = 10000.0;
+    double symbol_order_burst = 200.0;
+};
+
+// Reasons an order can fail the pre-trade check (bit positions)
+enum RiskReject : uint32_t {
+    REJECT_LOSS_LIMIT,
+    REJECT_ORDER_SIZE,
+    REJECT_PRICE_BAND,
+    REJECT_STRATEGY_THROTTLE,
+    REJECT_SYMBOL_THROTTLE,
+    REJECT_POSITION,
+    REJECT_SYMBOL_POSITION,
+    REJECT_STRATEGY_POSITION,
+    REJECT_NET_NOTIONAL,
+    REJECT_GROSS_NOTIONAL,
+    kNumRiskRejects
+};
+
+inline const char* riskRejectName(uint32_t reason) {
+    static const char* const names[kNumRiskRejects] = {
+        "Loss Limit", "Order Size", "Price Band", "Strategy Throttle", "Symbol Throttle", "Position",
+        "Symbol Position", "Strategy Position", "Net Notional", "Gross Notional"};
+    return reason < kNumRiskRejects ? names[reason] : "Unknown";
+}
+
+// Risk Manager
+// Accounting lives in cache-line-padded per-thread slots that only their
+// owning thread writes (plain stores, no RMW, no shared lines); totals are
+// summed from the slots on read and by aggregate().
+//
+// reserveOrder evaluates the stateless checks (loss limit, order size,
+// price band) as a reject bitmask without branching per check, takes a
+// token from the symbol and strategy rate limiters, then walks
+// a fixed table of exposure rows - global, per-symbol and per-strategy
+// position, net and gross notional - reserving each with a single
+// fetch_sub on a headroom counter and unwinding on the first overdraw.
+// Every limit is therefore checked and consumed in one atomic step, so
+// concurrent orders cannot slip past a limit together. Fills and cancels
+// from OrderManager (ExecutionListener) move or release the reservations.
+//
+// Limits can change while trading: the stateless ones are a LiveParams
+// block (checks must run inside an EpochGuard), and a new maximum moves
+// its headroom counter by the difference, so exposure already reserved
+// stays counted.
+class RiskManager : public ExecutionListener {
+private:
+    static constexpr size_t kMaxThreadSlots = 64;
+    static constexpr double kQuantityScale = 1e6;   // fixed-point units per share
+    static constexpr double kNotionalScale = 1e2;   // fixed-point units per currency unit
+    static constexpr size_t kExposureRows = 5;
+
+    struct alignas(64) ThreadSlot {
+        std::atomic<int64_t> position{0};        // filled net position delta
+        std::atomic<int64_t> inflight_buy{0};
+        std::atomic<int64_t> inflight_sell{0};
+        std::atomic<double> pnl{0.0};
+    };
+
+    // Long headroom = max - (position + in-flight buys);
+    // short headroom = max + (position - in-flight sells)
+    struct alignas(64) Headroom {
+        std::atomic<int64_t> side[2];            // indexed by OrderType
+        int64_t max;
+    };
+
+    struct SymbolRisk {
+        Headroom position;
+        TokenBucket throttle;
+        std::atomic<double> max_order_quantity;
+        std::atomic<double> reference_price{0.0};
+        bool custom = false;                     // setSymbolLimits overrides the defaults
+    };
+
+    struct alignas(64) StrategyRisk {
+        Headroom position;
+        TokenBucket throttle;
+        std::atomic<uint64_t> throttled{0};
+        bool custom = false;
+    };
+
+    struct ExposureRow {
+        std::atomic<int64_t>* reserve;           // consumed when the order is reserved
+        std::atomic<int64_t>* fill_release;      // credited when the order fills
+        int64_t amount;
+        uint32_t reject;
+    };
+
+    LiveParams<RiskLimits> limits_;
+    std::mutex update_mutex_;                    // serializes limit changes
+    std::array<ThreadSlot, kMaxThreadSlots> slots_;
+    std::atomic<size_t> slots_used_{0};
+    const uint64_t generation_ = nextGeneration();   // never reused, unlike the address
+
+    Headroom position_;
+    Headroom net_notional_;
+    alignas(64) std::atomic<int64_t> gross_notional_;
+    int64_t gross_notional_max_;
+    std::vector<SymbolRisk> symbols_;
+    std::array<StrategyRisk, kNumStrategyTypes> strategies_;
+
+    const PnlEngine* pnl_source_ = nullptr;
+    std::atomic<double> aggregated_pnl_{0.0};   // refreshed by aggregate()
+    std::array<std::atomic<uint64_t>, kNumRiskRejects> reject_counts_{};
+
+public:
+    explicit RiskManager(const RiskLimits& limits = RiskLimits()) 
+        : limits_(limits), symbols_(SymbolTable::kMaxSymbols) {
+        initHeadroom(position_, toFixed(limits.max_position));
+        initHeadroom(net_notional_, toNotional(limits.max_net_notional));
+        gross_notional_max_ = toNotional(limits.max_gross_notional);
+        gross_notional_.store(gross_notional_max_);
+        for (auto& symbol : symbols_) {
+            initHeadroom(symbol.position, toFixed(limits.symbol_max_position));
+            symbol.throttle.configure(limits.symbol_order_rate, limits.symbol_order_burst);
+            symbol.max_order_quantity.store(limits.max_order_quantity, std::memory_order_relaxed);
+        }
+        for (auto& strategy : strategies_) {
+            initHeadroom(strategy.position, toFixed(limits.strategy_max_position));
+            strategy.throttle.configure(limits.strategy_order_rate, limits.strategy_order_burst);
+        }
+    }
+
+    // Setup-time overrides (call before trading starts); later updateLimits
+    // calls leave these symbols and strategies alone
+    void setSymbolLimits(Symbol symbol, double max_position, double max_order_quantity,
+                         double order_rate, double order_burst) {
+        std::lock_guard<std::mutex> lock(update_mutex_);
+        SymbolRisk& risk = symbols_[symbol.id()];
+        resizeHeadroom(risk.position, toFixed(max_position));
+        risk.throttle.configure(order_rate, order_burst);
+        risk.max_order_quantity.store(max_order_quantity, std::memory_order_relaxed);
+        risk.custom = true;
+    }
+
+    void setStrategyLimits(StrategyType type, double max_position, double order_rate, double order_burst) {
+        std::lock_guard<std::mutex> lock(update_mutex_);
+        StrategyRisk& risk = strategies_[static_cast<size_t>(type)];
+        resizeHeadroom(risk.position, toFixed(max_position));
+        risk.throttle.configure(order_rate, order_burst);
+        risk.custom = true;
+    }
+
+    // Operator thread, while trading. A lowered maximum can leave headroom
+    // negative, which rejects that side until exposure unwinds below it.
+    void updateLimits(const RiskLimits& limits) {
+        std::lock_guard<std::mutex> lock(update_mutex_);
+        resizeHeadroom(position_, toFixed(limits.max_position));
+        resizeHeadroom(net_notional_, toNotional(limits.max_net_notional));
+        int64_t gross_max = toNotional(limits.max_gross_notional);
+        gross_notional_.fetch_add(gross_max - gross_notional_max_, std::memory_order_acq_rel);
+        gross_notional_max_ = gross_max;
+        for (auto& symbol : symbols_) {
+            if (symbol.custom) continue;
+            resizeHeadroom(symbol.position, toFixed(limits.symbol_max_position));
+            symbol.throttle.configure(limits.symbol_order_rate, limits.symbol_order_burst);
+            symbol.max_order_quantity.store(limits.max_order_quantity, std::memory_order_relaxed);
+        }
+        for (auto& strategy : strategies_) {
+            if (strategy.custom) continue;
+            resizeHeadroom(strategy.position, toFixed(limits.strategy_max_position));
+            strategy.throttle.configure(limits.strategy_order_rate, limits.strategy_order_burst);
+        }
+        limits_.publish(limits);
+    }
+
+    // Current limits; only valid inside an EpochGuard
+    const RiskLimits& limits() const { return limits_.read(); }
+
+    // Fill-driven P&L counted toward the loss limit (set before trading starts)
+    void setPnlSource(const PnlEngine* pnl_engine) { pnl_source_ = pnl_engine; }
+
+    // Mid price used for the price-band (fat finger) check
+    void updateReferencePrice(Symbol symbol, double mid) {
+        symbols_[symbol.id()].reference_price.store(mid, std::memory_order_relaxed);
+    }
+
+    double getReferencePrice(Symbol symbol) const {
+        return symbols_[symbol.id()].reference_price.load(std::memory_order_relaxed);
+    }
+
+    // Runs every pre-trade check and reserves the order's worst-case
+    // exposure; false means rejected (reason counted in getRejectCount).
+    // Call inside an EpochGuard.
+    bool reserveOrder(const Order& order) {
+        if (order.action == OrderAction::CANCEL) return true;    // carries no exposure
+        SymbolRisk& symbol = symbols_[order.symbol.id()];
+        StrategyRisk& strategy = strategies_[static_cast<size_t>(order.strategy)];
+
+        const RiskLimits& limits = limits_.read();
+        const double mid = symbol.reference_price.load(std::memory_order_relaxed);
+        const double deviation = std::abs(order.price - mid);
+        const double max_quantity = symbol.max_order_quantity.load(std::memory_order_relaxed);
+        uint32_t reject =
+            uint32_t(aggregated_pnl_.load(std::memory_order_relaxed) < limits.daily_loss_limit) << REJECT_LOSS_LIMIT |
+            uint32_t(!std::isfinite(order.quantity) | !(order.quantity > 0.0) |
+                     (order.quantity > max_quantity)) << REJECT_ORDER_SIZE |
+            uint32_t(!std::isfinite(order.price) | !(mid > 0.0) |
+                     !(deviation <= limits.price_band * mid)) << REJECT_PRICE_BAND;
+        if (reject) return rejectOrder(reject);
+
+        // Throttles: tokens are taken before exposure, so a later reject keeps
+        // costing rate budget, which is what stops a rejected-order storm
+        const uint64_t now = TscClock::now();
+        if (!symbol.throttle.tryAcquire(now)) {
+            strategy.throttled.fetch_add(1, std::memory_order_relaxed);
+            return rejectOrder(1u << REJECT_SYMBOL_THROTTLE);
+        }
+        if (!strategy.throttle.tryAcquire(now)) {
+            symbol.throttle.refund();
+            strategy.throttled.fetch_add(1, std::memory_order_relaxed);
+            return rejectOrder(1u << REJECT_STRATEGY_THROTTLE);
+        }
+
+        std::array<ExposureRow, kExposureRows> rows = exposureRows(order, symbol, strategy);
+        for (size_t i = 0; i < kExposureRows; ++i) {
+            if (rows[i].reserve->fetch_sub(rows[i].amount, std::memory_order_acq_rel) < rows[i].amount) {
+                for (size_t j = 0; j <= i; ++j) {
+                    rows[j].reserve->fetch_add(rows[j].amount, std::memory_order_acq_rel);
+                }
+                return rejectOrder(1u << rows[i].reject);
+            }
+        }
+
+        ThreadSlot& slot = localSlot();
+        addTo(order.type == OrderType::BUY ? slot.inflight_buy : slot.inflight_sell, toFixed(order.quantity));
+        return true;
+    }
+
+    // Returns a reservation for an order that never reached the market
+    void releaseOrder(const Order& order) {
+        if (order.action != OrderAction::CANCEL) onCancel(order);
+    }
+
+    void onFill(const Order& order) override {
+        const int64_t quantity = toFixed(order.quantity);
+        ThreadSlot& slot = localSlot();
+        if (order.type == OrderType::BUY) {
+            addTo(slot.inflight_buy, -quantity);
+            addTo(slot.position, quantity);
+        } else {
+            addTo(slot.inflight_sell, -quantity);
+            addTo(slot.position, -quantity);
+        }
+
+        // A filled buy stays counted on the long side and frees short capacity
+        for (const auto& row : exposureRows(order)) {
+            row.fill_release->fetch_add(row.amount, std::memory_order_acq_rel);
+        }
+    }
+
+    // An AMEND reserved its new exposure up front; the replaced version's
+    // reservation is released once OrderManager applies it
+    void onAmend(const Order& previous, const Order&) override { onCancel(previous); }
+
+    void onCancel(const Order& order) override {
+        ThreadSlot& slot = localSlot();
+        addTo(order.type == OrderType::BUY ? slot.inflight_buy : slot.inflight_sell, -toFixed(order.quantity));
+
+        for (const auto& row : exposureRows(order)) {
+            row.reserve->fetch_add(row.amount, std::memory_order_acq_rel);
+        }
+    }
+
+    void updatePnL(double pnl) {
+        std::atomic<double>& slot_pnl = localSlot().pnl;
+        slot_pnl.store(slot_pnl.load(std::memory_order_relaxed) + pnl, std::memory_order_relaxed);
+    }
+
+    // Folds per-thread P&L into the value the loss-limit check reads
+    void aggregate() { aggregated_pnl_.store(getCurrentPnL(), std::memory_order_relaxed); }
+
+    double getCurrentPosition() const { return sumSlots(&ThreadSlot::position) / kQuantityScale; }
+    double getInFlightBuys() const { return sumSlots(&ThreadSlot::inflight_buy) / kQuantityScale; }
+    double getInFlightSells() const { return sumSlots(&ThreadSlot::inflight_sell) / kQuantityScale; }
+
+    // Mark-to-market P&L from the P&L engine plus any per-thread adjustments
+    double getCurrentPnL() const {
+        double total = pnl_source_ ? pnl_source_->getTotalPnL() : 0.0;
+        size_t used = std::min(slots_used_.load(std::memory_order_acquire), kMaxThreadSlots);
+        for (size_t i = 0; i < used; ++i) total += slots_[i].pnl.load(std::memory_order_relaxed);
+        return total;
+    }
+
+    uint64_t getRejectCount(uint32_t reason) const {
+        return reject_counts_[reason].load(std::memory_order_relaxed);
+    }
+
+    // Orders from a strategy refused by either token bucket
+    uint64_t getThrottledCount(StrategyType type) const {
+        return strategies_[static_cast<size_t>(type)].throttled.load(std::memory_order_relaxed);
+    }
+
+private:
+    static int64_t toFixed(double quantity) { return std::llround(quantity * kQuantityScale); }
+    static int64_t toNotional(double notional) { return std::llround(notional * kNotionalScale); }
+
+    static void initHeadroom(Headroom& headroom, int64_t max) {
+        headroom.max = max;
+        headroom.side[0].store(max);
+        headroom.side[1].store(max);
+    }
+
+    // Writers hold update_mutex_; reservations in flight keep their share
+    static void resizeHeadroom(Headroom& headroom, int64_t max) {
+        int64_t delta = max - headroom.max;
+        if (delta == 0) return;
+        headroom.max = max;
+        headroom.side[0].fetch_add(delta);
+        headroom.side[1].fetch_add(delta);
+    }
+
+    std::array<ExposureRow, kExposureRows> exposureRows(const Order& order) {
+        return exposureRows(order, symbols_[order.symbol.id()],
+                            strategies_[static_cast<size_t>(order.strategy)]);
+    }
+
+    std::array<ExposureRow, kExposureRows> exposureRows(const Order& order, SymbolRisk& symbol,
+                                                        StrategyRisk& strategy) {
+        const size_t side = static_cast<size_t>(order.type);
+        const size_t opposite = side ^ 1;
+        const int64_t quantity = toFixed(order.quantity);
+        const int64_t notional = toNotional(order.price * order.quantity);
+        return {{
+            {&position_.side[side], &position_.side[opposite], quantity, REJECT_POSITION},
+            {&symbol.position.side[side], &symbol.position.side[opposite], quantity, REJECT_SYMBOL_POSITION},
+            {&strategy.position.side[side], &strategy.position.side[opposite], quantity, REJECT_STRATEGY_POSITION},
+            {&net_notional_.side[side], &net_notional_.side[opposite], notional, REJECT_NET_NOTIONAL},
+            {&gross_notional_, &gross_notional_, notional, REJECT_GROSS_NOTIONAL},
+        }};
+    }
+
+    bool rejectOrder(uint32_t reject_mask) {
+        reject_counts_[__builtin_ctz(reject_mask)].fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // Slot owned by the calling thread (claimed on first use)
+    // A thread claims one slot per manager, keyed by the manager's generation
+    // so switching managers reuses its slot and a manager rebuilt at the same
+    // address claims afresh. The last manager used is the fast path.
+    ThreadSlot& localSlot() {
+        thread_local uint64_t last_generation = 0;
+        thread_local size_t last_index = 0;
+        if (last_generation != generation_) {
+            thread_local std::unordered_map<uint64_t, size_t> claimed;
+            auto it = claimed.find(generation_);
+            if (it == claimed.end()) {
+                size_t index = slots_used_.fetch_add(1, std::memory_order_acq_rel);
+                if (index >= kMaxThreadSlots) {
+                    throw std::length_error("RiskManager: too many threads");
+                }
+                it = claimed.emplace(generation_, index).first;
+            }
+            last_generation = generation_;
+            last_index = it->second;
+        }
+        return slots_[last_index];
+    }
+
+    static uint64_t nextGeneration() {
+        static std::atomic<uint64_t> generation{1};
+        return generation.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Slots have a single writer, so a plain load/store replaces the RMW
+    static void addTo(std::atomic<int64_t>& value, int64_t delta) {
+        value.store(value.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+    }
+
+    int64_t sumSlots(std::atomic<int64_t> ThreadSlot::*field) const {
+        int64_t total = 0;
+        size_t used = std::min(slots_used_.load(std::memory_order_acquire), kMaxThreadSlots);
+        for (size_t i = 0; i < used; ++i) total += (slots_[i].*field).load(std::memory_order_relaxed);
+        return total;
+    }
+};
+
+// Why trading was halted
+enum class HaltReason : uint8_t { NONE, OPERATOR, LOSS_LIMIT, POSITION_BREACH, LATENCY };
+
+inline const char* haltReasonName(HaltReason reason) {
+    switch (reason) {
+        case HaltReason::OPERATOR: return "operator";
+        case HaltReason::LOSS_LIMIT: return "loss limit";
+        case HaltReason::POSITION_BREACH: return "position breach";
+        case HaltReason::LATENCY: return "latency";
+        default: return "none";
+    }
+}
+
+// Kill Switch - a single halt epoch every hot loop polls with one relaxed
+// load; odd epochs are halted, even epochs are trading. Tripping is a CAS
+// so concurrent triggers record exactly one reason per halt
+class KillSwitch {
+private:
+    alignas(64) std::atomic<uint64_t> epoch_{0};
+    std::atomic<HaltReason> reason_{HaltReason::NONE};
+    std::atomic<uint64_t> trips_{0};
+
+public:
+    bool halted() const { return epoch_.load(std::memory_order_relaxed) & 1; }
+    uint64_t epoch() const { return epoch_.load(std::memory_order_acquire); }
+
+    // Returns false if trading was already halted
+    bool trip(HaltReason reason) {
+        uint64_t epoch = epoch_.load(std::memory_order_relaxed);
+        while (!(epoch & 1)) {
+            if (epoch_.compare_exchange_weak(epoch, epoch + 1, std::memory_order_acq_rel)) {
+                reason_.store(reason, std::memory_order_relaxed);
+                trips_.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Returns false if trading was not halted
+    bool reset() {
+        uint64_t epoch = epoch_.load(std::memory_order_relaxed);
+        while (epoch & 1) {
+            if (epoch_.compare_exchange_weak(epoch, epoch + 1, std::memory_order_acq_rel)) {
+                reason_.store(HaltReason::NONE, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    HaltReason reason() const { return reason_.load(std::memory_order_relaxed); }
+    uint64_t tripCount() const { return trips_.load(std::memory_order_relaxed); }
+};
+
+// Automatic halt triggers evaluated by the engine after every tick
+struct CircuitBreakerConfig {
+    bool halt_on_loss_limit = true;             // P&L below RiskLimits::daily_loss_limit
+    bool halt_on_position_breach = true;        // |position| above RiskLimits::max_position
+    double max_tick_latency_ms = 250.0;         // feed-to-engine tick age (0 = off)
+    int latency_breach_ticks = 1000;            // consecutive slow ticks before halting
+};
+
+// Fast Random Number Generator (xoshiro256+) for simulation hot loops
+class FastRng {
+private:
+    static constexpr int kNormalTableBits = 12;
+    static constexpr size_t kNormalTableSize = size_t(1) << kNormalTableBits;
+
+    uint64_t s_[4];
+
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    // Inverse normal CDF (Acklam's rational approximation), used to build the table
+    static double inverseNormalCdf(double p) {
+        static const double a[] = {-3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+                                   1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00};
+        static const double b[] = {-5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+                                   6.680131188771972e+01, -1.328068155288572e+01};
+        static const double c[] = {-7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+                                   -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00};
+        static const double d[] = {7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00,
+                                   3.754408661907416e+00};
+        if (p < 0.02425) {
+            double q = std::sqrt(-2.0 * std::log(p));
+            return (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+                   ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+        }
+        if (p > 1.0 - 0.02425) return -inverseNormalCdf(1.0 - p);
+        double q = p - 0.5, r = q * q;
+        return (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q /
+               (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1.0);
+    }
+
+    static const std::array<double, kNormalTableSize + 1>& normalTable() {
+        static const std::array<double, kNormalTableSize + 1> table = [] {
+            std::array<double, kNormalTableSize + 1> t{};
+            for (size_t i = 0; i <= kNormalTableSize; ++i) {
+                t[i] = inverseNormalCdf((i + 0.5) / (kNormalTableSize + 1));
+            }
+            return t;
+        }();
+        return table;
+    }
+
+public:
+    explicit FastRng(uint64_t seed) {
+        // SplitMix64 expands the seed into the full state
+        for (auto& word : s_) {
+            seed += 0x9e3779b97f4a7c15ULL;
+            uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            word = z ^ (z >> 31);
+        }
+        normalTable();
+    }
+
+    uint64_t next() {
+        const uint64_t result = s_[0] + s_[3];
+        const uint64_t t = s_[1] << 17;
+        s_[2] ^= s_[0];
+        s_[3] ^= s_[1];
+        s_[1] ^= s_[2];
+        s_[0] ^= s_[3];
+        s_[2] ^= t;
+        s_[3] = rotl(s_[3], 45);
+        return result;
+    }
+
+    // Uniform in [0, 1)
+    double uniform() { return static_cast<double>(next() >> 11) * 0x1.0p-53; }
+
+    // Uniform in (0, 1], safe to take the log of
+    double uniformPositive() { return static_cast<double>((next() >> 11) + 1) * 0x1.0p-53; }
+
+    double exponential() { return -fastLog(uniformPositive()); }
+
+    // Standard normal from an interpolated inverse-CDF table (tails clipped
+    // near 3.7 sigma; heavy tails come from the jump process instead)
+    double normal() {
+        uint64_t bits = next();
+        size_t index = bits >> (64 - kNormalTableBits);
+        double frac = static_cast<double>((bits >> 11) & ((uint64_t(1) << (53 - kNormalTableBits)) - 1))
+                      * (1.0 / static_cast<double>(uint64_t(1) << (53 - kNormalTableBits)));
+        const auto& table = normalTable();
+        return table[index] + frac * (table[index + 1] - table[index]);
+    }
+
+    // Natural log for positive normal doubles, ~1e-10 relative error
+    static double fastLog(double x) {
+        uint64_t bits;
+        std::memcpy(&bits, &x, sizeof(bits));
+        int64_t exponent = static_cast<int64_t>((bits >> 52) & 0x7ff) - 1023;
+        bits = (bits & 0x000fffffffffffffULL) | 0x3ff0000000000000ULL;
+        double m;
+        std::memcpy(&m, &bits, sizeof(m));
+        if (m > 1.4142135623730951) {
+            m *= 0.5;
+            ++exponent;
+        }
+        double t = (m - 1.0) / (m + 1.0);
+        double t2 = t * t;
+        double series = t * (2.0 + t2 * (2.0 / 3.0 + t2 * (2.0 / 5.0 + t2 * (2.0 / 7.0 + t2 * (2.0 / 9.0 + t2 * (2.0 / 11.0))))));
+        return exponent * 0.6931471805599453 + series;
+    }
+};
+
+enum class Side : uint8_t { BID, ASK };
+enum class BookEventType : uint8_t { ADD, CANCEL, TRADE, QUOTE };
+
+// Book Event - one L2/L3 market-by-order update produced by the simulator
+struct BookEvent {
+    uint64_t order_id;       // L3 order reference (0 for QUOTE)
+    double time;             // simulated seconds since start
+    double price;
+    double quantity;         // order quantity added, cancelled or traded
+    double level_quantity;   // L2 aggregate resting at price after the event
+    SymbolId symbol;
+    BookEventType type;
+    Side side;
+    uint8_t level;           // 0 = top of book
+};
+
+// Venue Anchor - the lead venue's fundamental price per symbol, read by the
+// simulators of the other venues (one writing feed per symbol)
+class VenueAnchor {
+private:
+    std::array<std::atomic<double>, SymbolTable::kMaxSymbols> price_{};
+
+public:
+    void store(SymbolId id, double price) { price_[id].store(price, std::memory_order_relaxed); }
+    double load(SymbolId id) const { return price_[id].load(std::memory_order_relaxed); }
+};
+
+// Per-symbol overrides of the simulator defaults. A cross is quoted from two
+// other simulated symbols, price(numerator) / price(denominator), offset by an
+// OU basis like a follower venue (e.g. ETH/BTC from ETH/USD and BTC/USD)
+struct InstrumentConfig {
+    std::string symbol;
+    double initial_price = 0.0;          // 0 = SimulatorConfig::initial_price
+    double tick_size = 0.0;              // 0 = SimulatorConfig::tick_size
+    std::string cross_numerator;         // empty = own price process
+    std::string cross_denominator;
+};
+
+// Simulator Parameters
+struct SimulatorConfig {
+    std::vector<std::string> symbols{"BTC/USD"};
+    double initial_price = 50000.0;
+    double tick_size = 0.01;
+    int depth_levels = 5;
+    uint64_t seed = 0;                  // 0 = seed from std::random_device
+
+    // Geometric Brownian motion with compound Poisson jumps (per simulated second)
+    double drift = 0.0;
+    double volatility = 0.0001;              // ~56% annualized
+    double jump_intensity = 0.2;
+    double jump_mean = 0.0;
+    double jump_stddev = 0.002;
+
+    // Mean-reverting spread in ticks (Ornstein-Uhlenbeck, floored at one tick)
+    double spread_mean_ticks = 10.0;
+    double spread_reversion = 50.0;
+    double spread_volatility = 20.0;
+
+    // Self-exciting (Hawkes) order arrivals: intensity = base + sum(excitation * e^(-decay * age))
+    double hawkes_base_rate = 1000.0;
+    double hawkes_excitation = 800.0;
+    double hawkes_decay = 1000.0;
+
+    // Event mix and sizes
+    double add_probability = 0.55;
+    double cancel_probability = 0.35;  // remainder are trades
+    double mean_order_size = 10.0;
+
+    // Multi-venue: the lead venue publishes its price to `anchor`; any other
+    // venue quotes anchor * e^basis instead of running its own GBM, the basis
+    // an OU process whose jumps are venue-local dislocations
+    VenueId venue = kLeadVenue;
+    std::shared_ptr<VenueAnchor> anchor;
+    double basis_reversion = 20.0;
+    double basis_volatility = 0.000002;
+    double dislocation_intensity = 0.5;
+    double dislocation_stddev = 0.0001;
+
+    std::vector<InstrumentConfig> instruments;
+
+    // Price increment of a symbol, after its instrument override
+    double tickSizeOf(const std::string& symbol) const {
+        for (const auto& instrument : instruments) {
+            if (instrument.symbol == symbol && instrument.tick_size > 0.0) return instrument.tick_size;
+        }
+        return tick_size;
+    }
+};
+
+// BTC/USD, ETH/USD and the ETH/BTC cross, for triangular arbitrage
+inline void addTriangleUniverse(SimulatorConfig& config) {
+    config.symbols = {"BTC/USD", "ETH/USD", "ETH/BTC"};
+    config.instruments = {
+        {"ETH/USD", 3000.0, 0.01, "", ""},
+        {"ETH/BTC", 0.0, 0.0000001, "ETH/USD", "BTC/USD"},
+    };
+    config.dislocation_intensity = 50.0;
+}
+
+// Market Simulator - GBM + jumps, stochastic spread and Hawkes order flow
+// across many symbols. Per-symbol state is laid out as flat arrays and the
+// next arrival of every symbol is kept in a min-heap, so each event costs
+// O(log symbols) and events come out in simulated-time order.
+class MarketSimulator {
+public:
+    static constexpr int kMaxDepth = 16;
+    static constexpr int kOrdersPerLevel = 4;
+
+private:
+    struct RestingOrder {
+        uint64_t id;
+        double quantity;
+    };
+
+    struct Level {
+        double quantity;
+        uint8_t head;
+        uint8_t count;
+        RestingOrder orders[kOrdersPerLevel];  // FIFO ring, oldest first
+    };
+
+    SimulatorConfig config_;
+    FastRng rng_;
+    size_t num_symbols_;
+    int depth_;
+
+    std::vector<SymbolId> symbol_ids_;
+    std::vector<uint32_t> index_of_;      // SymbolId -> local index
+    std::vector<double> price_;           // fundamental (continuous) price
+    std::vector<double> basis_;           // log offset from the anchor or cross legs
+    std::vector<double> tick_size_;
+    std::vector<uint32_t> cross_numerator_;   // local indices; num_symbols_ if not a cross
+    std::vector<uint32_t> cross_denominator_;
+    std::vector<double> spread_ticks_;
+    std::vector<double> hawkes_excess_;   // intensity above base after last event
+    std::vector<double> hawkes_decay_;    // e^(-decay * wait) for the pending arrival
+    std::vector<double> last_time_;
+    std::vector<double> next_time_;
+    std::vector<int64_t> best_bid_tick_;
+    std::vector<int64_t> best_ask_tick_;
+    std::vector<Level> levels_;           // [symbol][side][level]
+    std::vector<uint32_t> heap_;          // symbol indices ordered by next_time_
+    uint64_t next_order_id_;
+    bool follower_;
+
+public:
+    explicit MarketSimulator(const SimulatorConfig& config)
+        : config_(config),
+          rng_(config.seed ? config.seed : (static_cast<uint64_t>(std::random_device{}()) << 32) ^ std::random_device{}()),
+          num_symbols_(config.symbols.size()),
+          depth_(std::clamp(config.depth_levels, 1, kMaxDepth)),
+          next_order_id_(1),
+          follower_(config.anchor && config.venue != kLeadVenue) {
+        if (num_symbols_ == 0) {
+            throw std::invalid_argument("MarketSimulator: no symbols configured");
+        }
+        if (config_.hawkes_excitation >= config_.hawkes_decay) {
+            throw std::invalid_argument("MarketSimulator: Hawkes process must be stationary (excitation < decay)");
+        }
+
+        symbol_ids_.reserve(num_symbols_);
+        index_of_.assign(SymbolTable::kMaxSymbols, static_cast<uint32_t>(num_symbols_));
+        for (const auto& name : config_.symbols) {
+            SymbolId id = SymbolTable::instance().intern(name);
+            index_of_[id] = static_cast<uint32_t>(symbol_ids_.size());
+            symbol_ids_.push_back(id);
+        }
+        price_.assign(num_symbols_, config_.initial_price);
+        basis_.assign(num_symbols_, 0.0);
+        tick_size_.assign(num_symbols_, config_.tick_size);
+        cross_numerator_.assign(num_symbols_, static_cast<uint32_t>(num_symbols_));
+        cross_denominator_.assign(num_symbols_, static_cast<uint32_t>(num_symbols_));
+        configureInstruments();
+        spread_ticks_.assign(num_symbols_, config_.spread_mean_ticks);
+        hawkes_excess_.assign(num_symbols_, 0.0);
+        hawkes_decay_.assign(num_symbols_, 1.0);
+        last_time_.assign(num_symbols_, 0.0);
+        next_time_.assign(num_symbols_, 0.0);
+        best_bid_tick_.assign(num_symbols_, 0);
+        best_ask_tick_.assign(num_symbols_, 0);
+        levels_.assign(num_symbols_ * 2 * depth_, Level{});
+
+        for (size_t i = 0; i < num_symbols_; ++i) {
+            if (config_.anchor && !follower_) config_.anchor->store(symbol_ids_[i], price_[i]);
+            best_bid_tick_[i] = quoteBidTick(i);
+            best_ask_tick_[i] = best_bid_tick_[i] + spreadTicks(i);
+            for (int side = 0; side < 2; ++side) {
+                for (int l = 0; l < depth_; ++l) {
+                    seedLevel(level(i, side, l));
+                }
+            }
+            next_time_[i] = nextArrival(i);
+            heap_.push_back(static_cast<uint32_t>(i));
+        }
+        std::make_heap(heap_.begin(), heap_.end(), [this](uint32_t a, uint32_t b) {
+            return next_time_[a] > next_time_[b];
+        });
+    }
+
+    // Fills `out` with up to `max_events` events; returns the number written.
+    size_t generate(BookEvent* out, size_t max_events) {
+        size_t produced = 0;
+        while (produced + 2 <= max_events) {
+            uint32_t i = heap_.front();
+            produced += step(i, out + produced);
+            next_time_[i] = nextArrival(i);
+            siftDownTop();
+        }
+        return produced;
+    }
+
+    size_t symbolCount() const { return num_symbols_; }
+    SymbolId symbolId(size_t index) const { return symbol_ids_[index]; }
+    double price(size_t index) const { return price_[index]; }
+    double bestBid(size_t index) const { return best_bid_tick_[index] * tick_size_[index]; }
+    double bestAsk(size_t index) const { return best_ask_tick_[index] * tick_size_[index]; }
+
+    double levelQuantity(size_t index, Side side, int lvl) const {
+        return levels_[levelIndex(index, static_cast<int>(side), lvl)].quantity;
+    }
+
+    // Local index of a simulated symbol, or symbolCount() if not simulated
+    size_t indexOf(SymbolId id) const { return index_of_[id]; }
+
+    // Top-of-book view of a symbol, as published to the engine
+    MarketData topOfBook(size_t index, double volume) const {
+        return MarketData(Symbol(symbol_ids_[index]), price_[index], volume,
+                          bestBid(index), bestAsk(index), config_.venue);
+    }
+
+private:
+    void configureInstruments() {
+        auto local = [this](const std::string& name) {
+            uint32_t index = index_of_[Symbol(name).id()];
+            if (index == num_symbols_) {
+                throw std::invalid_argument("MarketSimulator: " + name + " is not a simulated symbol");
+            }
+            return index;
+        };
+        for (const auto& instrument : config_.instruments) {
+            uint32_t i = local(instrument.symbol);
+            if (instrument.initial_price > 0.0) price_[i] = instrument.initial_price;
+            if (instrument.tick_size > 0.0) tick_size_[i] = instrument.tick_size;
+            if (!instrument.cross_numerator.empty()) {
+                cross_numerator_[i] = local(instrument.cross_numerator);
+                cross_denominator_[i] = local(instrument.cross_denominator);
+                if (isCross(cross_numerator_[i]) || isCross(cross_denominator_[i])) {
+                    throw std::invalid_argument("MarketSimulator: cross legs must have their own price process");
+                }
+            }
+        }
+        for (size_t i = 0; i < num_symbols_; ++i) {
+            if (isCross(i)) price_[i] = crossPrice(i);
+        }
+    }
+
+    bool isCross(size_t i) const { return cross_numerator_[i] != num_symbols_; }
+
+    double crossPrice(size_t i) const {
+        return price_[cross_numerator_[i]] / price_[cross_denominator_[i]];
+    }
+
+    // OU step of the basis plus a possible dislocation jump
+    double stepBasis(size_t i, double dt, double sqrt_dt) {
+        double b = basis_[i];
+        b += -config_.basis_reversion * b * dt + config_.basis_volatility * sqrt_dt * rng_.normal();
+        if (rng_.uniform() < config_.dislocation_intensity * dt) {
+            b += config_.dislocation_stddev * rng_.normal();
+        }
+        basis_[i] = b;
+        return b;
+    }
+
+    size_t levelIndex(size_t i, int side, int lvl) const {
+        return (i * 2 + side) * depth_ + lvl;
+    }
+
+    Level& level(size_t i, int side, int lvl) { return levels_[levelIndex(i, side, lvl)]; }
+
+    int64_t spreadTicks(size_t i) const {
+        return std::max<int64_t>(1, std::llround(spread_ticks_[i]));
+    }
+
+    int64_t quoteBidTick(size_t i) const {
+        double mid_ticks = price_[i] / tick_size_[i];
+        return static_cast<int64_t>(std::floor(mid_ticks - 0.5 * spreadTicks(i)));
+    }
+
+    double levelPrice(size_t i, int side, int lvl) const {
+        int64_t tick = side == 0 ? best_bid_tick_[i] - lvl : best_ask_tick_[i] + lvl;
+        return tick * tick_size_[i];
+    }
+
+    // e^x, using a Taylor expansion for the tiny per-event returns
+    static double expSmall(double x) {
+        if (std::abs(x) > 1e-3) return std::exp(x);
+        return 1.0 + x * (1.0 + x * (0.5 + x * (1.0 / 6.0 + x * (1.0 / 24.0))));
+    }
+
+    double drawSize() { return std::ceil(config_.mean_order_size * rng_.exponential()); }
+
+    void pushOrder(Level& lv, double quantity) {
+        if (lv.count == kOrdersPerLevel) {
+            // Queue full: merge into the newest order to keep memory fixed
+            lv.orders[(lv.head + lv.count - 1) % kOrdersPerLevel].quantity += quantity;
+        } else {
+            lv.orders[(lv.head + lv.count) % kOrdersPerLevel] = {next_order_id_++, quantity};
+            ++lv.count;
+        }
+        lv.quantity += quantity;
+    }
+
+    void seedLevel(Level& lv) {
+        lv = Level{};
+        pushOrder(lv, drawSize());
+    }
+
+    // Exact next inter-arrival of an exponential-kernel Hawkes process
+    // (Dassios & Zhao): two candidate waits, the excited one and the base one.
+    // When the excited wait wins, its decay factor is `d` itself, saving an exp.
+    double nextArrival(size_t i) {
+        double excess = hawkes_excess_[i];
+        double wait = rng_.exponential() / config_.hawkes_base_rate;
+        double decay = -1.0;
+        if (excess > 0.0) {
+            double d = 1.0 + config_.hawkes_decay * FastRng::fastLog(rng_.uniformPositive()) / excess;
+            if (d > 0.0) {
+                double excited_wait = -FastRng::fastLog(d) / config_.hawkes_decay;
+                if (excited_wait < wait) {
+                    wait = excited_wait;
+                    decay = d;
+                }
+            }
+        }
+        hawkes_decay_[i] = decay >= 0.0 ? decay : std::exp(-config_.hawkes_decay * wait);
+        return last_time_[i] + wait;
+    }
+
+    // Advances one symbol to its next arrival and emits one or two events.
+    size_t step(size_t i, BookEvent* out) {
+        const double now = next_time_[i];
+        const double dt = now - last_time_[i];
+        last_time_[i] = now;
+        hawkes_excess_[i] = hawkes_excess_[i] * hawkes_decay_[i] + config_.hawkes_excitation;
+
+        const double sqrt_dt = std::sqrt(dt);
+        if (follower_) {
+            // Price: the lead's latest price offset by this venue's basis
+            double b = stepBasis(i, dt, sqrt_dt);
+            double anchor = config_.anchor->load(symbol_ids_[i]);
+            if (anchor > 0.0) price_[i] = anchor * expSmall(b);
+        } else if (isCross(i)) {
+            // Price: ratio of the legs' latest prices offset by the basis
+            price_[i] = crossPrice(i) * expSmall(stepBasis(i, dt, sqrt_dt));
+            if (config_.anchor) config_.anchor->store(symbol_ids_[i], price_[i]);
+        } else {
+            // Price: GBM increment plus a possible jump over dt
+            const double sigma = config_.volatility;
+            double log_return = (config_.drift - 0.5 * sigma * sigma) * dt + sigma * sqrt_dt * rng_.normal();
+            if (rng_.uniform() < config_.jump_intensity * dt) {
+                log_return += config_.jump_mean + config_.jump_stddev * rng_.normal();
+            }
+            price_[i] *= expSmall(log_return);
+            if (config_.anchor) config_.anchor->store(symbol_ids_[i], price_[i]);
+        }
+
+        // Spread: Euler step of an OU process, reflected at one tick
+        double s = spread_ticks_[i];
+        s += config_.spread_reversion * (config_.spread_mean_ticks - s) * dt
+             + config_.spread_volatility * sqrt_dt * rng_.normal();
+        spread_ticks_[i] = s < 1.0 ? 2.0 - s : s;
+
+        size_t produced = 0;
+        int64_t bid_tick = quoteBidTick(i);
+        int64_t ask_tick = bid_tick + spreadTicks(i);
+        if (bid_tick != best_bid_tick_[i] || ask_tick != best_ask_tick_[i]) {
+            // A rising bid pushes resting bids deeper; a rising ask drops the asks it crossed
+            shiftSide(i, 0, bid_tick - best_bid_tick_[i]);
+            shiftSide(i, 1, best_ask_tick_[i] - ask_tick);
+            best_bid_tick_[i] = bid_tick;
+            best_ask_tick_[i] = ask_tick;
+            out[produced++] = BookEvent{0, now, price_[i], 0.0, levels_[levelIndex(i, 0, 0)].quantity,
+                                        symbol_ids_[i], BookEventType::QUOTE, Side::BID, 0};
+        }
+
+        out[produced++] = orderFlowEvent(i, now);
+        return produced;
+    }
+
+    BookEvent orderFlowEvent(size_t i, double now) {
+        const int side = static_cast<int>(rng_.next() & 1);
+        const double u = rng_.uniform();
+
+        // Activity decays geometrically away from the touch
+        int lvl = 0;
+        while (lvl + 1 < depth_ && (rng_.next() & 1)) ++lvl;
+
+        BookEvent ev{};
+        ev.time = now;
+        ev.symbol = symbol_ids_[i];
+        ev.side = static_cast<Side>(side);
+
+        if (u < config_.add_probability) {
+            Level& lv = level(i, side, lvl);
+            double quantity = drawSize();
+            pushOrder(lv, quantity);
+            ev.type = BookEventType::ADD;
+            ev.order_id = lv.orders[(lv.head + lv.count - 1) % kOrdersPerLevel].id;
+            ev.quantity = quantity;
+            ev.level = static_cast<uint8_t>(lvl);
+            ev.level_quantity = lv.quantity;
+            ev.price = levelPrice(i, side, lvl);
+        } else if (u < config_.add_probability + config_.cancel_probability) {
+            Level& lv = level(i, side, lvl);
+            RestingOrder& order = lv.orders[(lv.head + rng_.next() % lv.count) % kOrdersPerLevel];
+            ev.type = BookEventType::CANCEL;
+            ev.order_id = order.id;
+            ev.quantity = order.quantity;
+            removeOrder(lv, order);
+            ev.level = static_cast<uint8_t>(lvl);
+            ev.level_quantity = lv.quantity;
+            ev.price = levelPrice(i, side, lvl);
+        } else {
+            // An aggressor trades against the front order at the touch of `side`
+            Level& lv = level(i, side, 0);
+            RestingOrder& order = lv.orders[lv.head];
+            double quantity = std::min(order.quantity, drawSize());
+            ev.type = BookEventType::TRADE;
+            ev.order_id = order.id;
+            ev.quantity = quantity;
+            order.quantity -= quantity;
+            lv.quantity -= quantity;
+            if (order.quantity <= 0.0) removeOrder(lv, order);
+            ev.level = 0;
+            ev.level_quantity = lv.quantity;
+            ev.price = levelPrice(i, side, 0);
+        }
+        return ev;
+    }
+
+    void removeOrder(Level& lv, RestingOrder& order) {
+        lv.quantity -= order.quantity;
+        // Close the gap by moving the oldest order into the freed slot
+        order = lv.orders[lv.head];
+        lv.head = static_cast<uint8_t>((lv.head + 1) % kOrdersPerLevel);
+        --lv.count;
+        if (lv.count == 0) {
+            // Keep every level populated; a replenishing order arrives
+            seedLevel(lv);
+        }
+    }
+
+    // Re-anchors one side when its touch moves by `shift` levels (positive =
+    // existing levels move deeper). Levels shifted out of the window are
+    // dropped and newly exposed levels are seeded with fresh liquidity.
+    void shiftSide(size_t i, int side, int64_t shift) {
+        Level* lv = &levels_[levelIndex(i, side, 0)];
+        if (shift == 0) return;
+        if (std::llabs(shift) >= depth_) {
+            for (int l = 0; l < depth_; ++l) seedLevel(lv[l]);
+        } else if (shift > 0) {
+            std::move_backward(lv, lv + depth_ - shift, lv + depth_);
+            for (int l = 0; l < shift; ++l) seedLevel(lv[l]);
+        } else {
+            std::move(lv - shift, lv + depth_, lv);
+            for (int l = depth_ + static_cast<int>(shift); l < depth_; ++l) seedLevel(lv[l]);
+        }
+    }
+
+    void siftDownTop() {
+        const size_t n = heap_.size();
+        const uint32_t item = heap_[0];
+        const double key = next_time_[item];
+        size_t pos = 0;
+        while (true) {
+            size_t child = 2 * pos + 1;
+            if (child >= n) break;
+            if (child + 1 < n && next_time_[heap_[child + 1]] < next_time_[heap_[child]]) ++child;
+            if (next_time_[heap_[child]] >= key) break;
+            heap_[pos] = heap_[child];
+            pos = child;
+        }
+        heap_[pos] = item;
+    }
+};
+
+// Market Data Sink - destination the feed publishes ticks into
+class MarketDataSink {
+public:
+    virtual ~MarketDataSink() = default;
+
+    // Returns false if the tick was dropped
+    virtual bool publish(const MarketData& data) = 0;
+};
+
+class QueueMarketDataSink : public MarketDataSink {
+private:
+    ThreadSafeQueue<MarketData>& queue_;
+
+public:
+    explicit QueueMarketDataSink(ThreadSafeQueue<MarketData>& queue) : queue_(queue) {}
+
+    bool publish(const MarketData& data) override { return queue_.push(data); }
+};
+
+// Adapter: feed writes each tick once into a broadcast ring
+class BroadcastMarketDataSink : public MarketDataSink {
+private:
+    BroadcastRing<MarketData>& ring_;
+
+public:
+    explicit BroadcastMarketDataSink(BroadcastRing<MarketData>& ring) : ring_(ring) {}
+
+    bool publish(const MarketData& data) override {
+        ring_.publish(data);
+        return true;
+    }
+};
+
+// Pipeline event: one slot per tick, filled in place as it moves through
+// the book, strategy, risk and dispatch stages. kMaxOrders covers every
+// built-in strategy firing on one tick; a strategy whose output doesn't fit
+// in what is left is dropped whole, never truncated, so a triangular cycle
+// is never sent with missing legs.
+struct PipelineEvent {
+    static constexpr size_t kMaxOrders = 32;
+
+    MarketData tick;
+    TopOfBook top;                      // book stage
+    std::array<Order, kMaxOrders> orders;   // strategy stage
+    uint8_t order_count;
+    uint32_t approved;                  // risk stage: bit i set if orders[i] passed
+};
+static_assert(PipelineEvent::kMaxOrders <= 32, "approved has one bit per order");
+
+enum PipelineStage : size_t { STAGE_BOOK, STAGE_STRATEGY, STAGE_RISK, STAGE_DISPATCH, kNumPipelineStages };
+
+using EventPipeline = StagedRing<PipelineEvent, kNumPipelineStages>;
+
+// Adapter: feed writes each tick straight into a pipeline slot
+class PipelineMarketDataSink : public MarketDataSink {
+private:
+    EventPipeline& pipeline_;
+
+public:
+    explicit PipelineMarketDataSink(EventPipeline& pipeline) : pipeline_(pipeline) {}
+
+    bool publish(const MarketData& data) override {
+        return pipeline_.publish([&](PipelineEvent& event) {
+            event.tick = data;
+            event.order_count = 0;
+            event.approved = 0;
+        });
+    }
+};
+
+// Adapter: lets several venue feeds share a single-producer sink
+class SerializedMarketDataSink : public MarketDataSink {
+private:
+    MarketDataSink& sink_;
+    std::mutex mutex_;
+
+public:
+    explicit SerializedMarketDataSink(MarketDataSink& sink) : sink_(sink) {}
+
+    bool publish(const MarketData& data) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return sink_.publish(data);
+    }
+};
+
+// Tick Conflator - latest tick per symbol in a seqlock'd slot plus a dirty
+// bitmap (with a summary word over the bitmap words). The consumer visits
+// only symbols that changed since its last drain, so work per cycle is
+// bounded by the number of changed symbols rather than by backlog length.
+// Each symbol's slot must have a single publishing thread.
+class TickConflator : public MarketDataSink {
+private:
+    static constexpr size_t kSlots = SymbolTable::kMaxSymbols;
+    static constexpr size_t kWords = kSlots / 64;
+    static_assert(kWords <= 64, "summary word covers at most 64 bitmap words");
+
+    std::vector<Seqlock<MarketData>> slots_;
+    std::array<std::atomic<uint64_t>, kWords> dirty_{};
+    alignas(64) std::atomic<uint64_t> summary_{0};
+
+    alignas(64) std::atomic<uint64_t> conflated_{0};
+    std::atomic<bool> consumer_waiting_{false};
+    std::mutex wait_mutex_;
+    std::condition_variable wait_condition_;
+
+public:
+    TickConflator() : slots_(kSlots) {}
+
+    bool publish(const MarketData& data) override {
+        const size_t id = data.symbol.id();
+        const uint64_t bit = uint64_t(1) << (id & 63);
+        slots_[id].store(data);
+        if (dirty_[id >> 6].fetch_or(bit, std::memory_order_seq_cst) & bit) {
+            // Previous tick for this symbol was never consumed
+            conflated_.fetch_add(1, std::memory_order_relaxed);
+        }
+        summary_.fetch_or(uint64_t(1) << (id >> 6), std::memory_order_seq_cst);
+
+        if (consumer_waiting_.load(std::memory_order_seq_cst)) {
+            std::lock_guard<std::mutex> lock(wait_mutex_);
+            wait_condition_.notify_one();
+        }
+        return true;
+    }
+
+    // Visits the latest tick of every dirty symbol; returns the count visited
+    template<typename Fn>
+    size_t drain(Fn&& fn) {
+        size_t visited = 0;
+        uint64_t words = summary_.exchange(0, std::memory_order_acquire);
+        while (words) {
+            size_t w = static_cast<size_t>(__builtin_ctzll(words));
+            words &= words - 1;
+            uint64_t bits = dirty_[w].exchange(0, std::memory_order_acquire);
+            while (bits) {
+                size_t id = w * 64 + static_cast<size_t>(__builtin_ctzll(bits));
+                bits &= bits - 1;
+                fn(slots_[id].load());
+                ++visited;
+            }
+        }
+        return visited;
+    }
+
+    // Blocks until some symbol is dirty or the timeout expires
+    void waitForData(const std::chrono::milliseconds& timeout) {
+        for (int spin = 0; spin < 64; ++spin) {
+            if (summary_.load(std::memory_order_acquire)) return;
+        }
+        std::unique_lock<std::mutex> lock(wait_mutex_);
+        consumer_waiting_.store(true, std::memory_order_seq_cst);
+        wait_condition_.wait_for(lock, timeout, [this] {
+            return summary_.load(std::memory_order_seq_cst) != 0;
+        });
+        consumer_waiting_.store(false, std::memory_order_relaxed);
+    }
+
+    // Number of symbols currently holding an unconsumed tick
+    size_t pendingCount() const {
+        size_t count = 0;
+        for (const auto& word : dirty_) {
+            count += static_cast<size_t>(__builtin_popcountll(word.load(std::memory_order_relaxed)));
+        }
+        return count;
+    }
+
+    uint64_t conflatedCount() const { return conflated_.load(std::memory_order_relaxed); }
+};
+
+// Feed Pacing
+// Pins a thread to one CPU (-1 leaves it to the scheduler). A CPU that
+// doesn't exist or isn't allowed is reported and the thread runs unpinned.
+inline void pinThread(std::thread& thread, int cpu, const char* name) {
+    if (cpu < 0 || !thread.joinable()) return;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    int error = cpu < CPU_SETSIZE ? pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set) : EINVAL;
+    if (error != 0) {
+        std::cerr << "Cannot pin " << name << " thread to CPU " << cpu << ": " << std::strerror(error) << std::endl;
+    }
+}
+
+enum class FeedMode { PACED, FIREHOSE };
+enum class BurstPattern { NONE, MARKET_OPEN, PERIODIC };
+
+struct FeedConfig {
+    FeedMode mode = FeedMode::PACED;
+    double target_rate = 1000.0;             // ticks/second in PACED mode
+    BurstPattern burst = BurstPattern::NONE;
+    double burst_multiplier = 10.0;          // peak rate = target_rate * multiplier
+    double burst_duration = 1.0;             // seconds (decay constant for MARKET_OPEN)
+    double burst_interval = 10.0;            // seconds between PERIODIC bursts
+};
+
+struct FeedStats {
+    std::atomic<uint64_t> published{0};
+    std::atomic<uint64_t> dropped{0};
+};
+
+// Market Data Feed
+class MarketDataFeed {
+private:
+    std::atomic<bool> running_;
+    std::thread feed_thread_;
+    MarketDataSink& sink_;
+    MarketSimulator simulator_;
+    FeedConfig config_;
+    FeedStats stats_;
+    std::array<BookEvent, 2> events_;
+
+public:
+    MarketDataFeed(MarketDataSink& sink, const SimulatorConfig& sim_config = SimulatorConfig(),
+                   const FeedConfig& feed_config = FeedConfig()) 
+        : running_(false), sink_(sink), simulator_(sim_config), config_(feed_config) {}
+
+    void start(int cpu = -1) {
+        running_ = true;
+        feed_thread_ = std::thread(&MarketDataFeed::feedLoop, this);
+        pinThread(feed_thread_, cpu, "feed");
+    }
+
+    void stop() {
+        running_ = false;
+        if (feed_thread_.joinable()) {
+            feed_thread_.join();
+        }
+    }
+
+    const FeedStats& getStats() const { return stats_; }
+
+    // Instantaneous target rate t seconds after start, including bursts
+    double targetRate(double t) const {
+        switch (config_.burst) {
+            case BurstPattern::MARKET_OPEN:
+                return config_.target_rate *
+                       (1.0 + (config_.burst_multiplier - 1.0) * std::exp(-t / config_.burst_duration));
+            case BurstPattern::PERIODIC:
+                return std::fmod(t, config_.burst_interval) < config_.burst_duration
+                           ? config_.target_rate * config_.burst_multiplier
+                           : config_.target_rate;
+            default:
+                return config_.target_rate;
+        }
+    }
+
+private:
+    void feedLoop() {
+        using Clock = std::chrono::steady_clock;
+        const auto start = Clock::now();
+        auto next_emit = start;
+
+        while (running_) {
+            if (config_.mode == FeedMode::PACED) {
+                auto now = Clock::now();
+                if (now < next_emit) {
+                    // Sleep when far ahead of schedule, spin for the last stretch
+                    if (next_emit - now > std::chrono::microseconds(200)) {
+                        std::this_thread::sleep_until(next_emit);
+                    } else {
+                        while (Clock::now() < next_emit) {}
+                    }
+                } else if (now - next_emit > std::chrono::milliseconds(100)) {
+                    // Too far behind to catch up; don't burst out the whole debt
+                    next_emit = now;
+                }
+                double t = std::chrono::duration<double>(next_emit - start).count();
+                next_emit += std::chrono::duration_cast<Clock::duration>(
+                    std::chrono::duration<double>(1.0 / targetRate(t)));
+            }
+
+            // Advance the simulator by one order-flow arrival
+            size_t count = simulator_.generate(events_.data(), events_.size());
+            const BookEvent& event = events_[count - 1];
+            MarketData data = simulator_.topOfBook(simulator_.indexOf(event.symbol), event.quantity);
+
+            if (sink_.publish(data)) {
+                stats_.published.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                stats_.dropped.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+};
+
+// Shared-memory transport sizes (fixed so every process agrees on layout)
+constexpr uint64_t kShmMagic = 0x48465453484d3033ULL;   // "HFTSHM03"
+constexpr size_t kShmRingBits = 14;
+constexpr size_t kShmRingSize = size_t(1) << kShmRingBits;
+constexpr size_t kShmOrderRingSize = 4096;
+constexpr size_t kShmMaxClients = 8;
+constexpr size_t kShmSymbolLength = 32;
+
+static_assert(std::is_trivially_copyable<MarketData>::value, "MarketData is copied between processes");
+static_assert(std::is_trivially_copyable<Order>::value, "Order is copied between processes");
+
+// One strategy process's order ring back to the engine (client produces,
+// server consumes). A slot is claimed by CAS on state and reclaimed from
+// a process that died without detaching.
+struct ShmClientRing {
+    enum : uint32_t { FREE, ATTACHED };
+    alignas(64) std::atomic<uint32_t> state{FREE};
+    std::atomic<int32_t> pid{0};
+    alignas(64) std::atomic<uint64_t> tail{0};     // next slot to write (client)
+    alignas(64) std::atomic<uint64_t> head{0};     // next slot to read (server)
+    Order orders[kShmOrderRingSize];
+};
+
+// Segment layout: header with the symbol table, a broadcast ring of
+// seqlock slots for market data, then the per-client order rings
+struct ShmSegment {
+    uint64_t magic = 0;
+    uint64_t size = 0;
+    std::atomic<uint32_t> server_alive{0};
+    std::atomic<uint32_t> symbol_count{0};
+    alignas(64) std::atomic<uint64_t> cursor{0};   // next sequence to publish
+    char symbols[SymbolTable::kMaxSymbols][kShmSymbolLength];
+    Seqlock<MarketData> ring[kShmRingSize];
+    ShmClientRing clients[kShmMaxClients];
+};
+
+// Maps a POSIX shared-memory object (visible under /dev/shm)
+class ShmMapping {
+private:
+    ShmSegment* segment_ = nullptr;
+
+public:
+    ShmMapping(const std::string& name, bool create) {
+        int flags = create ? (O_CREAT | O_RDWR | O_TRUNC) : O_RDWR;
+        int fd = shm_open(name.c_str(), flags, 0600);
+        if (fd < 0) {
+            throw std::runtime_error("shm_open(" + name + "): " + std::strerror(errno));
+        }
+        if (create && ftruncate(fd, sizeof(ShmSegment)) != 0) {
+            int error = errno;
+            close(fd);
+            throw std::runtime_error("ftruncate(" + name + "): " + std::strerror(error));
+        }
+        void* address = mmap(nullptr, sizeof(ShmSegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        int error = errno;
+        close(fd);
+        if (address == MAP_FAILED) {
+            throw std::runtime_error("mmap(" + name + "): " + std::strerror(error));
+        }
+        segment_ = static_cast<ShmSegment*>(address);
+    }
+
+    ~ShmMapping() { munmap(segment_, sizeof(ShmSegment)); }
+
+    ShmMapping(const ShmMapping&) = delete;
+    ShmMapping& operator=(const ShmMapping&) = delete;
+
+    ShmSegment* operator->() const { return segment_; }
+    ShmSegment& operator*() const { return *segment_; }
+};
+
+// Shm Server - engine side: broadcasts market data to any number of
+// strategy processes and collects their orders. publish() has a single
+// writer and never waits for readers; slow readers are lapped.
+class ShmServer {
+private:
+    std::string name_;
+    ShmMapping segment_;
+    size_t published_symbols_ = 0;
+    std::atomic<uint64_t> rejected_{0};
+
+public:
+    // Replaces any stale segment left by a previous run
+    explicit ShmServer(const std::string& name) : name_(name), segment_(name, true) {
+        new (&*segment_) ShmSegment();
+        segment_->size = sizeof(ShmSegment);
+        segment_->magic = kShmMagic;
+        segment_->server_alive.store(1, std::memory_order_release);
+    }
+
+    ~ShmServer() {
+        segment_->server_alive.store(0, std::memory_order_release);
+        shm_unlink(name_.c_str());
+    }
+
+    void publish(const MarketData& data) {
+        if (data.symbol.id() >= published_symbols_) publishSymbols();
+        uint64_t sequence = segment_->cursor.load(std::memory_order_relaxed);
+        segment_->ring[sequence & (kShmRingSize - 1)].store(data);
+        segment_->cursor.store(sequence + 1, std::memory_order_release);
+    }
+
+    // Calls fn(order) for up to max queued client orders. Order ids are
+    // moved into a per-client range so they can't collide with the engine's.
+    template<typename Fn>
+    size_t pollOrders(Fn&& fn, size_t max = 256) {
+        size_t count = 0;
+        for (size_t i = 0; i < kShmMaxClients && count < max; ++i) {
+            ShmClientRing& client = segment_->clients[i];
+            uint64_t head = client.head.load(std::memory_order_relaxed);
+            uint64_t tail = client.tail.load(std::memory_order_acquire);
+            for (; head != tail && count < max; ++head, ++count) {
+                Order order = client.orders[head % kShmOrderRingSize];
+                client.head.store(head + 1, std::memory_order_release);
+                if (!acceptable(order)) {
+                    rejected_.fetch_add(1, std::memory_order_relaxed);
+                    continue;
+                }
+                order.id = (uint64_t(i + 1) << 48) | (order.id & ((uint64_t(1) << 48) - 1));
+                fn(order);
+            }
+        }
+        return count;
+    }
+
+    size_t clientCount() const {
+        size_t count = 0;
+        for (const auto& client : segment_->clients) {
+            count += client.state.load(std::memory_order_relaxed) == ShmClientRing::ATTACHED;
+        }
+        return count;
+    }
+
+    uint64_t publishedCount() const { return segment_->cursor.load(std::memory_order_relaxed); }
+    uint64_t rejectedCount() const { return rejected_.load(std::memory_order_relaxed); }
+
+private:
+    // Client memory is untrusted: every field the engine indexes by or
+    // computes with is range-checked before the order reaches the risk path
+    bool acceptable(const Order& order) const {
+        return order.symbol.id() < published_symbols_ && order.venue < kMaxVenues &&
+               static_cast<size_t>(order.strategy) < kNumStrategyTypes &&
+               static_cast<int>(order.type) >= 0 && static_cast<int>(order.type) <= static_cast<int>(OrderType::SELL) &&
+               static_cast<uint8_t>(order.action) <= static_cast<uint8_t>(OrderAction::CANCEL) &&
+               std::isfinite(order.price) && std::isfinite(order.quantity) &&
+               order.price > 0.0 && order.quantity > 0.0;
+    }
+
+    // Copies newly interned names before the tick that first uses them
+    void publishSymbols() {
+        const SymbolTable& table = SymbolTable::instance();
+        size_t count = table.size();
+        for (size_t id = published_symbols_; id < count; ++id) {
+            std::strncpy(segment_->symbols[id], table.name(static_cast<SymbolId>(id)).c_str(),
+                         kShmSymbolLength - 1);
+        }
+        published_symbols_ = count;
+        segment_->symbol_count.store(static_cast<uint32_t>(count), std::memory_order_release);
+    }
+};
+
+// Shm Client - strategy process side. Symbols are re-interned locally from
+// the segment's table, so ids are translated in both directions.
+class ShmClient {
+private:
+    ShmMapping segment_;
+    ShmClientRing* ring_ = nullptr;
+    uint64_t cursor_ = 0;
+    uint64_t lapped_ = 0;
+    std::vector<SymbolId> to_local_;
+    std::vector<SymbolId> to_server_;
+
+public:
+    explicit ShmClient(const std::string& name)
+        : segment_(name, false), to_server_(SymbolTable::kMaxSymbols, 0) {
+        if (segment_->magic != kShmMagic || segment_->size != sizeof(ShmSegment)) {
+            throw std::runtime_error("ShmClient: " + name + " has an incompatible layout");
+        }
+        if (!serverAlive()) throw std::runtime_error("ShmClient: no server on " + name);
+        for (auto& client : segment_->clients) {
+            if (claim(client)) {
+                ring_ = &client;
+                break;
+            }
+        }
+        if (!ring_) throw std::runtime_error("ShmClient: all client slots in use");
+        cursor_ = segment_->cursor.load(std::memory_order_acquire);  // start from live data
+    }
+
+    ~ShmClient() { ring_->state.store(ShmClientRing::FREE, std::memory_order_release); }
+
+    // Next tick in sequence; if the writer lapped us, skip to the newest
+    bool poll(MarketData& out) {
+        uint64_t published = segment_->cursor.load(std::memory_order_acquire);
+        while (cursor_ < published) {
+            if (published - cursor_ > kShmRingSize) {
+                skipTo(published - 1);
+                continue;
+            }
+            uint64_t version;
+            const Seqlock<MarketData>& slot = segment_->ring[cursor_ & (kShmRingSize - 1)];
+            if (!slot.tryLoad(out, version) || version != 2 * ((cursor_ >> kShmRingBits) + 1)) {
+                published = segment_->cursor.load(std::memory_order_acquire);
+                skipTo(published - 1);
+                continue;
+            }
+            ++cursor_;
+            out.symbol = Symbol(localSymbol(out.symbol.id()));
+            return true;
+        }
+        return false;
+    }
+
+    // False if the engine hasn't drained this client's ring
+    bool sendOrder(const Order& order) {
+        uint64_t tail = ring_->tail.load(std::memory_order_relaxed);
+        if (tail - ring_->head.load(std::memory_order_acquire) >= kShmOrderRingSize) return false;
+        Order& slot = ring_->orders[tail % kShmOrderRingSize];
+        slot = order;
+        slot.symbol = Symbol(to_server_[order.symbol.id()]);
+        ring_->tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool serverAlive() const { return segment_->server_alive.load(std::memory_order_acquire) != 0; }
+    uint64_t lappedCount() const { return lapped_; }
+
+private:
+    bool claim(ShmClientRing& client) {
+        uint32_t state = client.state.load(std::memory_order_acquire);
+        if (state == ShmClientRing::ATTACHED) {
+            int32_t owner = client.pid.load(std::memory_order_relaxed);
+            if (owner <= 0 || kill(owner, 0) == 0 || errno != ESRCH) return false;
+        }
+        if (!client.state.compare_exchange_strong(state, ShmClientRing::ATTACHED,
+                                                  std::memory_order_acq_rel)) {
+            return false;
+        }
+        client.pid.store(static_cast<int32_t>(getpid()), std::memory_order_relaxed);
+        return true;
+    }
+
+    void skipTo(uint64_t sequence) {
+        lapped_ += sequence - cursor_;
+        cursor_ = sequence;
+    }
+
+    SymbolId localSymbol(SymbolId server_id) {
+        if (server_id >= to_local_.size()) {
+            size_t count = segment_->symbol_count.load(std::memory_order_acquire);
+            for (size_t id = to_local_.size(); id < count; ++id) {
+                char name[kShmSymbolLength];
+                std::memcpy(name, segment_->symbols[id], kShmSymbolLength);
+                name[kShmSymbolLength - 1] = '\0';
+                SymbolId local = Symbol(name).id();
+                to_local_.push_back(local);
+                to_server_[local] = static_cast<SymbolId>(id);
+            }
+        }
+        return to_local_[server_id];
+    }
+};
+
+// Simulated depth around a tick's touch: the book is replaced so levels
+// from earlier prices can't leave it crossed
+inline void applyTickToBook(OrderBook& book, const MarketData& data, FastRng& rng) {
+    // Levels a tick apart. A book without a tick size (a strategy client's)
+    // spaces them by the spread, which is a whole number of ticks.
+    const double step = book.tickSize() > 0.0 ? book.tickSize() : (data.spread > 0.0 ? data.spread : 0.01);
+    OrderBook::Batch batch(book);
+    batch.clear();
+    for (int i = 0; i < 5; ++i) {
+        batch.updateBid(data.bid - (i * step), 1.0 + 49.0 * rng.uniform());
+        batch.updateAsk(data.ask + (i * step), 1.0 + 49.0 * rng.uniform());
+    }
+}
+
+// Simulated venue behaviour for orders that don't fill on arrival
+struct ExecutionConfig {
+    double fill_probability = 0.9;              // immediate fill on arrival
+    double resting_fill_probability = 0.05;     // per sweep while resting
+    double resting_ttl_ms = 10.0;               // unfilled orders expire after this
+    // Orders behind the mid fill with probability scaled by e^(-decay * distance)
+    // (distance in bps of mid, as the market maker's fill model assumes); 0 = price-blind
+    double passive_fill_decay = 100.0;
+    double order_latency_us = 100.0;            // simulated venue round trip per order (0 = none)
+};
+
+// Order Manager
+class OrderManager {
+private:
+    std::atomic<bool> running_;
+    std::thread processing_thread_;
+    ThreadSafeQueue<Order>& order_queue_;
+    const KillSwitch* kill_switch_;
+    ExecutionConfig config_;
+    std::atomic<uint64_t> filled_count_{0};
+    std::atomic<uint64_t> processed_count_{0};
+    std::atomic<uint64_t> mass_cancelled_{0};
+    std::atomic<uint64_t> amended_{0};
+    std::atomic<uint64_t> cancel_requests_{0};
+    std::atomic<size_t> live_count_{0};
+    std::vector<ExecutionListener*> listeners_;
+    std::unordered_map<uint64_t, Order> live_orders_;   // processing thread only
+    FastRng rng_{std::random_device{}()};               // processing thread only
+    const RiskManager* reference_prices_ = nullptr;
+
+public:
+    OrderManager(ThreadSafeQueue<Order>& queue, const KillSwitch* kill_switch = nullptr,
+                 const ExecutionConfig& config = ExecutionConfig())
+        : running_(false), order_queue_(queue), kill_switch_(kill_switch), config_(config) {}
+
+    // Register before start(); listeners are called on the processing thread
+    void addListener(ExecutionListener* listener) { listeners_.push_back(listener); }
+
+    // Mid prices for the passive fill model (set before start)
+    void setReferencePrices(const RiskManager* risk_manager) { reference_prices_ = risk_manager; }
+
+    void start(int cpu = -1) {
+        running_ = true;
+        processing_thread_ = std::thread(&OrderManager::processOrders, this);
+        pinThread(processing_thread_, cpu, "order manager");
+    }
+
+    void stop() {
+        running_ = false;
+        if (processing_thread_.joinable()) {
+            processing_thread_.join();
+        }
+    }
+
+    // Fills are reported to the listeners (PnlEngine keeps the positions)
+    uint64_t getFilledCount() const { return filled_count_.load(std::memory_order_relaxed); }
+    uint64_t getProcessedCount() const { return processed_count_.load(std::memory_order_relaxed); }
+    uint64_t getMassCancelledCount() const { return mass_cancelled_.load(std::memory_order_relaxed); }
+    uint64_t getAmendedCount() const { return amended_.load(std::memory_order_relaxed); }
+    uint64_t getCancelRequestCount() const { return cancel_requests_.load(std::memory_order_relaxed); }
+    size_t getLiveOrderCount() const { return live_count_.load(std::memory_order_relaxed); }
+
+private:
+    void processOrders() {
+        while (running_) {
+            // Halt check first: everything queued or resting is cancelled
+            // in this cycle instead of reaching the venue
+            if (kill_switch_ && kill_switch_->halted()) {
+                cancelAll();
+                Order order;
+                if (order_queue_.pop(order, std::chrono::milliseconds(1))) {
+                    // A cancel request has nothing left to cancel
+                    if (order.action != OrderAction::CANCEL) {
+                        cancelOrder(order);
+                        mass_cancelled_.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    processed_count_.fetch_add(1, std::memory_order_relaxed);
+                }
+                continue;
+            }
+
+            Order order;
+            if (order_queue_.pop(order, std::chrono::milliseconds(1))) {
+                // Simulate order processing latency
+                if (config_.order_latency_us > 0.0) {
+                    std::this_thread::sleep_for(std::chrono::duration<double, std::micro>(config_.order_latency_us));
+                }
+                
+                if (order.action == OrderAction::AMEND) {
+                    amendOrder(order);
+                } else if (order.action == OrderAction::CANCEL) {
+                    cancelLiveOrder(order.id);
+                } else if (rng_.uniform() < fillProbability(order, config_.fill_probability)) {
+                    fillOrder(order);
+                } else {
+                    live_orders_.emplace(order.id, order);
+                }
+                processed_count_.fetch_add(1, std::memory_order_relaxed);
+            }
+            sweepLiveOrders();
+        }
+        cancelAll();
+    }
+
+    // Replaces a live order's price and size in place; the amended order may
+    // fill on arrival like a new one. If the order already filled or expired
+    // the amend itself is cancelled so its risk reservation is released.
+    void amendOrder(Order& amend) {
+        auto it = live_orders_.find(amend.id);
+        if (it == live_orders_.end()) {
+            cancelOrder(amend);
+            return;
+        }
+        amended_.fetch_add(1, std::memory_order_relaxed);
+        Order previous = it->second;
+        Order& order = it->second;
+        order.price = amend.price;
+        order.quantity = amend.quantity;
+        order.timestamp = amend.timestamp;
+        for (auto* listener : listeners_) listener->onAmend(previous, order);
+        if (rng_.uniform() < fillProbability(order, config_.fill_probability)) {
+            fillOrder(order);
+            live_orders_.erase(it);
+        }
+    }
+
+    // Cancel request for a live order; a no-op if it already completed
+    void cancelLiveOrder(uint64_t id) {
+        cancel_requests_.fetch_add(1, std::memory_order_relaxed);
+        auto it = live_orders_.find(id);
+        if (it == live_orders_.end()) return;
+        cancelOrder(it->second);
+        live_orders_.erase(it);
+    }
+
+    // Resting orders either fill late or expire
+    void sweepLiveOrders() {
+        if (live_orders_.empty()) return;
+        auto expiry = std::chrono::high_resolution_clock::now() -
+                      std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(
+                          std::chrono::duration<double, std::milli>(config_.resting_ttl_ms));
+        for (auto it = live_orders_.begin(); it != live_orders_.end();) {
+            if (rng_.uniform() < fillProbability(it->second, config_.resting_fill_probability)) {
+                fillOrder(it->second);
+            } else if (it->second.timestamp < expiry) {
+                cancelOrder(it->second);
+            } else {
+                ++it;
+                continue;
+            }
+            it = live_orders_.erase(it);
+        }
+        live_count_.store(live_orders_.size(), std::memory_order_relaxed);
+    }
+
+    // Orders at or through the mid keep the base probability
+    double fillProbability(const Order& order, double base) const {
+        if (!reference_prices_ || config_.passive_fill_decay <= 0.0) return base;
+        const double mid = reference_prices_->getReferencePrice(order.symbol);
+        if (!(mid > 0.0)) return base;
+        const double behind = (order.type == OrderType::BUY ? mid - order.price : order.price - mid) / mid *
+                              kBasisPointsPerUnit;
+        return behind > 0.0 ? base * std::exp(-config_.passive_fill_decay * behind) : base;
+    }
+
+    void cancelAll() {
+        if (live_orders_.empty()) return;
+        for (auto& entry : live_orders_) cancelOrder(entry.second);
+        mass_cancelled_.fetch_add(live_orders_.size(), std::memory_order_relaxed);
+        live_orders_.clear();
+        live_count_.store(0, std::memory_order_relaxed);
+    }
+
+    void fillOrder(Order& order) {
+        order.status = OrderStatus::FILLED;
+        filled_count_.store(filled_count_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        for (auto* listener : listeners_) listener->onFill(order);
+    }
+
+    void cancelOrder(Order& order) {
+        order.status = OrderStatus::CANCELLED;
+        for (auto* listener : listeners_) listener->onCancel(order);
+    }
+};
+
+// Queue sizing and overflow behaviour
+struct QueueConfig {
+    size_t capacity;                         // 0 = unbounded
+    OverflowPolicy policy;
+};
+
+// How ticks travel from the feed to the engine thread
+enum class MarketDataPath { QUEUE, CONFLATED, BROADCAST, PIPELINE };
+
+// Engine Options
+// CPU per thread, -1 = unpinned
+struct ThreadPlacement {
+    int feed = -1;                // venue v's feed on feed + v
+    int engine = -1;              // PIPELINE path: stage s on engine + s
+    int orders = -1;
+    int ui = -1;
+};
+
+struct EngineOptions {
+    SimulatorConfig simulator;
+    FeedConfig feed;
+    RiskLimits risk;
+    CircuitBreakerConfig breakers;
+    ExecutionConfig execution;
+    MarketMakingConfig market_making;
+    ArbitrageConfig arbitrage;
+    MomentumConfig momentum;
+    MeanReversionConfig mean_reversion;
+    CrossVenueConfig cross_venue;
+    TriangularConfig triangular;
+    ThreadPlacement threads;
+    MarketDataPath market_data_path = MarketDataPath::QUEUE;
+    // Market data keeps only the latest tick per symbol under load; orders
+    // are never dropped, so a full order queue pushes back on the engine
+    QueueConfig market_data_queue{65536, OverflowPolicy::CONFLATE};
+    QueueConfig order_queue{65536, OverflowPolicy::BLOCK};
+    // BROADCAST path: ring size comes from market_data_queue.capacity; the
+    // engine gates the feed until it stalls it this long, then is lapped
+    std::chrono::microseconds broadcast_max_stall{1000};
+    size_t pipeline_capacity = 4096;         // PIPELINE path: event slots in the ring
+    size_t max_batch = 1024;                 // QUEUE path: ticks drained per pop (1 = per tick)
+    bool batched_signals = true;             // screen a batch's symbols with SignalKernel
+    std::string shm_name;                    // serve out-of-process strategies (empty = off)
+    // One feed per venue; venue 0 leads and the others quote around its
+    // price. More than one venue needs a path keyed by venue (not CONFLATED)
+    size_t venues = 1;
+    bool show_ui = true;
+    size_t ui_refresh_ms = 500;              // dashboard redraw period
+};
+
+// Engine Configuration - an INI-style file plus `--set section.key=value`
+// overrides, parsed once at startup into EngineOptions so nothing is looked
+// up once the engine is built. Every option has a "section.key" name:
+//
+//   [risk]                       # comments start with '#' or ';'
+//   max_position = 10000
+//   [instrument ETH/BTC]         # per-symbol overrides (InstrumentConfig)
+//   tick_size = 0.0000001
+//
+// Unknown keys, malformed values and numbers outside an option's range
+// (non-finite floating point values included) throw std::invalid_argument.
+class EngineConfig {
+public:
+    static void loadFile(EngineOptions& options, const std::string& path) {
+        std::ifstream file(path);
+        if (!file) throw std::invalid_argument("EngineConfig: cannot open " + path);
+        std::string line, section;
+        for (size_t number = 1; std::getline(file, line); ++number) {
+            line = trim(line.substr(0, line.find_first_of("#;")));
+            if (line.empty()) continue;
+            try {
+                if (line.front() == '[') {
+                    if (line.back() != ']') throw std::invalid_argument("EngineConfig: unterminated section");
+                    section = trim(line.substr(1, line.size() - 2));
+                    size_t space = section.find(' ');
+                    if (space != std::string::npos) section = section.substr(0, space) + "." + trim(section.substr(space));
+                    continue;
+                }
+                size_t equals = line.find('=');
+                if (equals == std::string::npos) throw std::invalid_argument("EngineConfig: expected key = value");
+                std::string key = trim(line.substr(0, equals));
+                set(options, section.empty() ? key : section + "." + key, trim(line.substr(equals + 1)));
+            } catch (const std::invalid_argument& e) {
+                throw std::invalid_argument(path + ":" + std::to_string(number) + ": " + e.what());
+            }
+        }
+    }
+
+    // `assignment` is "section.key=value"
+    static void set(EngineOptions& options, const std::string& assignment) {
+        size_t equals = assignment.find('=');
+        if (equals == std::string::npos) throw std::invalid_argument("EngineConfig: expected key=value: " + assignment);
+        set(options, trim(assignment.substr(0, equals)), trim(assignment.substr(equals + 1)));
+    }
+
+    static void set(EngineOptions& options, const std::string& key, const std::string& value) {
+        if (key.compare(0, 11, "instrument.") == 0) {
+            setInstrument(options.simulator, key, value);
+            return;
+        }
+        for (const auto& field : fields()) {
+            if (field.key == key) {
+                field.parse(options, value);
+                return;
+            }
+        }
+        throw std::invalid_argument("EngineConfig: unknown option " + key);
+    }
+
+    // Rules spanning several options, checked once all of them are applied
+    static void validate(const EngineOptions& options) {
+        const SimulatorConfig& simulator = options.simulator;
+        auto fail = [](const std::string& message) { throw std::invalid_argument("EngineConfig: " + message); };
+        if (simulator.hawkes_excitation >= simulator.hawkes_decay) {
+            fail("simulator.hawkes_excitation must be below simulator.hawkes_decay (stationary order flow)");
+        }
+        if (simulator.add_probability + simulator.cancel_probability > 1.0) {
+            fail("simulator.add_probability + simulator.cancel_probability must not exceed 1");
+        }
+        if (options.venues > 1 && options.market_data_path == MarketDataPath::CONFLATED) {
+            fail("engine.venues > 1 needs a market_data_path keyed by venue (not conflated)");
+        }
+        auto simulated = [&](const std::string& symbol) {
+            return std::find(simulator.symbols.begin(), simulator.symbols.end(), symbol) != simulator.symbols.end();
+        };
+        auto instrument = [&](const std::string& symbol) {
+            return std::find_if(simulator.instruments.begin(), simulator.instruments.end(),
+                                [&](const InstrumentConfig& i) { return i.symbol == symbol; });
+        };
+        for (const auto& config : simulator.instruments) {
+            if (!simulated(config.symbol)) fail("instrument " + config.symbol + " is not in simulator.symbols");
+            if (config.cross_numerator.empty() != config.cross_denominator.empty()) {
+                fail("instrument " + config.symbol + " needs both cross_numerator and cross_denominator");
+            }
+            for (const auto& leg : {config.cross_numerator, config.cross_denominator}) {
+                if (leg.empty()) continue;
+                if (!simulated(leg)) fail("instrument " + config.symbol + ": cross leg " + leg + " is not simulated");
+                auto it = instrument(leg);
+                if (it != simulator.instruments.end() && !it->cross_numerator.empty()) {
+                    fail("instrument " + config.symbol + ": cross leg " + leg + " is itself a cross");
+                }
+            }
+        }
+    }
+
+    // The complete effective configuration, in loadFile's format
+    static void write(std::ostream& os, const EngineOptions& options) {
+        std::string section;
+        for (const auto& field : fields()) {
+            std::string prefix = field.key.substr(0, field.key.find('.'));
+            if (prefix != section) {
+                os << (section.empty() ? "" : "\n") << "[" << prefix << "]\n";
+                section = prefix;
+            }
+            os << field.key.substr(prefix.size() + 1) << " = " << field.format(options) << "\n";
+        }
+        for (const auto& instrument : options.simulator.instruments) {
+            os << "\n[instrument " << instrument.symbol << "]\n"
+               << "initial_price = " << formatValue(instrument.initial_price) << "\n"
+               << "tick_size = " << formatValue(instrument.tick_size) << "\n";
+            if (!instrument.cross_numerator.empty()) {
+                os << "cross_numerator = " << instrument.cross_numerator << "\n"
+                   << "cross_denominator = " << instrument.cross_denominator << "\n";
+            }
+        }
+    }
+
+private:
+    // Accepted values of a numeric option
+    struct Range {
+        double min;
+        double max;
+        bool exclusive_min;
+
+        bool contains(double value) const {
+            return (exclusive_min ? value > min : value >= min) && value <= max;
+        }
+    };
+
+    static constexpr Range kAny{-HUGE_VAL, HUGE_VAL, false};
+    static constexpr Range kPositive{0.0, HUGE_VAL, true};
+    static constexpr Range kNonNegative{0.0, HUGE_VAL, false};
+    static constexpr Range kNonPositive{-HUGE_VAL, 0.0, false};
+    static constexpr Range kProbability{0.0, 1.0, false};
+    static constexpr Range kAtLeastOne{1.0, HUGE_VAL, false};
+    static constexpr Range kCpu{-1.0, HUGE_VAL, false};
+
+    struct Field {
+        std::string key;
+        std::function<void(EngineOptions&, const std::string&)> parse;
+        std::function<std::string(const EngineOptions&)> format;
+    };
+
+    template<typename E>
+    using EnumNames = std::vector<std::pair<std::string, E>>;
+
+    static const EnumNames<MarketDataPath>& enumNames(MarketDataPath) {
+        static const EnumNames<MarketDataPath> names{{"queue", MarketDataPath::QUEUE},
+                                                     {"conflated", MarketDataPath::CONFLATED},
+                                                     {"broadcast", MarketDataPath::BROADCAST},
+                                                     {"pipeline", MarketDataPath::PIPELINE}};
+        return names;
+    }
+    static const EnumNames<OverflowPolicy>& enumNames(OverflowPolicy) {
+        static const EnumNames<OverflowPolicy> names{{"block", OverflowPolicy::BLOCK},
+                                                     {"drop-oldest", OverflowPolicy::DROP_OLDEST},
+                                                     {"drop-newest", OverflowPolicy::DROP_NEWEST},
+                                                     {"conflate", OverflowPolicy::CONFLATE}};
+        return names;
+    }
+    static const EnumNames<FeedMode>& enumNames(FeedMode) {
+        static const EnumNames<FeedMode> names{{"paced", FeedMode::PACED}, {"firehose", FeedMode::FIREHOSE}};
+        return names;
+    }
+    static const EnumNames<BurstPattern>& enumNames(BurstPattern) {
+        static const EnumNames<BurstPattern> names{{"none", BurstPattern::NONE},
+                                                   {"open", BurstPattern::MARKET_OPEN},
+                                                   {"periodic", BurstPattern::PERIODIC}};
+        return names;
+    }
+
+    static std::string trim(const std::string& text) {
+        size_t begin = text.find_first_not_of(" \t\r");
+        if (begin == std::string::npos) return std::string();
+        return text.substr(begin, text.find_last_not_of(" \t\r") - begin + 1);
+    }
+
+    template<typename T>
+    static bool parseValue(const std::string& text, T& value) {
+        if constexpr (std::is_same_v<T, bool>) {
+            if (text == "true" || text == "on" || text == "1") value = true;
+            else if (text == "false" || text == "off" || text == "0") value = false;
+            else return false;
+            return true;
+        } else if constexpr (std::is_same_v<T, std::string>) {
+            value = text;
+            return true;
+        } else if constexpr (std::is_same_v<T, std::vector<std::string>>) {
+            std::vector<std::string> items;
+            std::stringstream stream(text);
+            for (std::string item; std::getline(stream, item, ',');) {
+                if (!trim(item).empty()) items.push_back(trim(item));
+            }
+            if (items.empty()) return false;
+            value = std::move(items);
+            return true;
+        } else if constexpr (std::is_enum_v<T>) {
+            for (const auto& [name, e] : enumNames(T{})) {
+                if (name == text) {
+                    value = e;
+                    return true;
+                }
+            }
+            return false;
+        } else {
+            size_t used = 0;
+            try {
+                if constexpr (std::is_floating_point_v<T>) {
+                    value = std::stod(text, &used);
+                } else if constexpr (std::is_signed_v<T>) {
+                    value = static_cast<T>(std::stoll(text, &used));
+                } else {
+                    if (text.find('-') != std::string::npos) return false;
+                    value = static_cast<T>(std::stoull(text, &used));
+                }
+            } catch (const std::logic_error&) {
+                return false;
+            }
+            return used == text.size();
+        }
+    }
+
+    template<typename T>
+    static std::string formatValue(const T& value) {
+        if constexpr (std::is_same_v<T, bool>) {
+            return value ? "true" : "false";
+        } else if constexpr (std::is_same_v<T, std::string>) {
+            return value;
+        } else if constexpr (std::is_same_v<T, std::vector<std::string>>) {
+            std::string text;
+            for (const auto& item : value) text += (text.empty() ? "" : ", ") + item;
+            return text;
+        } else if constexpr (std::is_enum_v<T>) {
+            for (const auto& [name, e] : enumNames(T{})) {
+                if (e == value) return name;
+            }
+            return "?";
+        } else if constexpr (std::is_floating_point_v<T>) {
+            std::ostringstream stream;
+            stream << std::setprecision(15) << value;
+            return stream.str();
+        } else {
+            return std::to_string(value);
+        }
+    }
+
+    // Parses into a temporary so a rejected value leaves the option unchanged
+    template<typename T>
+    static void assign(const std::string& key, const std::string& text, T& value, Range range = kAny) {
+        T parsed = value;
+        if (!parseValue(text, parsed)) throw std::invalid_argument("EngineConfig: " + key + ": bad value '" + text + "'");
+        if constexpr (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>) {
+            double number = static_cast<double>(parsed);
+            if (!std::isfinite(number)) throw std::invalid_argument("EngineConfig: " + key + ": " + text + " is not finite");
+            if (!range.contains(number)) {
+                throw std::invalid_argument("EngineConfig: " + key + ": " + text + " is outside " +
+                                            (range.exclusive_min ? "(" : "[") + formatValue(range.min) + ", " +
+                                            formatValue(range.max) + "]");
+            }
+        }
+        value = parsed;
+    }
+
+    template<typename T>
+    static Field field(const char* key, T EngineOptions::*member, Range range = kAny) {
+        std::string name = key;
+        return {name, [=](EngineOptions& o, const std::string& text) { assign(name, text, o.*member, range); },
+                [=](const EngineOptions& o) { return formatValue(o.*member); }};
+    }
+
+    template<typename S, typename T>
+    static Field field(const char* key, S EngineOptions::*section, T S::*member, Range range = kAny) {
+        std::string name = key;
+        return {name, [=](EngineOptions& o, const std::string& text) { assign(name, text, (o.*section).*member, range); },
+                [=](const EngineOptions& o) { return formatValue((o.*section).*member); }};
+    }
+
+    static void setInstrument(SimulatorConfig& simulator, const std::string& key, const std::string& value) {
+        size_t dot = key.rfind('.');
+        std::string symbol = key.substr(11, dot - 11);
+        std::string name = key.substr(dot + 1);
+        if (dot <= 11 || symbol.empty()) throw std::invalid_argument("EngineConfig: expected instrument.SYMBOL.key: " + key);
+        auto it = std::find_if(simulator.instruments.begin(), simulator.instruments.end(),
+                               [&](const InstrumentConfig& instrument) { return instrument.symbol == symbol; });
+        InstrumentConfig& instrument = it != simulator.instruments.end()
+                                           ? *it : simulator.instruments.emplace_back(InstrumentConfig{symbol, 0.0, 0.0, "", ""});
+        if (name == "initial_price") assign(key, value, instrument.initial_price, kNonNegative);
+        else if (name == "tick_size") assign(key, value, instrument.tick_size, kNonNegative);
+        else if (name == "cross_numerator") assign(key, value, instrument.cross_numerator);
+        else if (name == "cross_denominator") assign(key, value, instrument.cross_denominator);
+        else throw std::invalid_argument("EngineConfig: unknown option " + key);
+    }
+
+    static const std::vector<Field>& fields() {
+        using E = EngineOptions;
+        static const std::vector<Field> table{
+            field("engine.market_data_path", &E::market_data_path),
+            field("engine.venues", &E::venues, Range{1.0, static_cast<double>(kMaxVenues), false}),
+            field("engine.max_batch", &E::max_batch, kAtLeastOne),
+            field("engine.batched_signals", &E::batched_signals),
+            field("engine.pipeline_capacity", &E::pipeline_capacity, kAtLeastOne),
+            Field{"engine.broadcast_max_stall_us",
+                  [](E& o, const std::string& text) {
+                      int64_t us = 0;
+                      assign("engine.broadcast_max_stall_us", text, us, kNonNegative);
+                      o.broadcast_max_stall = std::chrono::microseconds(us);
+                  },
+                  [](const E& o) { return formatValue(static_cast<int64_t>(o.broadcast_max_stall.count())); }},
+            field("engine.shm_name", &E::shm_name),
+            field("engine.show_ui", &E::show_ui),
+            field("engine.ui_refresh_ms", &E::ui_refresh_ms, kAtLeastOne),
+
+            field("market_data_queue.capacity", &E::market_data_queue, &QueueConfig::capacity),
+            field("market_data_queue.policy", &E::market_data_queue, &QueueConfig::policy),
+            field("order_queue.capacity", &E::order_queue, &QueueConfig::capacity),
+            field("order_queue.policy", &E::order_queue, &QueueConfig::policy),
+
+            field("threads.feed", &E::threads, &ThreadPlacement::feed, kCpu),
+            field("threads.engine", &E::threads, &ThreadPlacement::engine, kCpu),
+            field("threads.orders", &E::threads, &ThreadPlacement::orders, kCpu),
+            field("threads.ui", &E::threads, &ThreadPlacement::ui, kCpu),
+
+            field("feed.mode", &E::feed, &FeedConfig::mode),
+            field("feed.target_rate", &E::feed, &FeedConfig::target_rate, kPositive),
+            field("feed.burst", &E::feed, &FeedConfig::burst),
+            field("feed.burst_multiplier", &E::feed, &FeedConfig::burst_multiplier, kPositive),
+            field("feed.burst_duration", &E::feed, &FeedConfig::burst_duration, kPositive),
+            field("feed.burst_interval", &E::feed, &FeedConfig::burst_interval, kPositive),
+
+            field("simulator.symbols", &E::simulator, &SimulatorConfig::symbols),
+            field("simulator.initial_price", &E::simulator, &SimulatorConfig::initial_price, kPositive),
+            field("simulator.tick_size", &E::simulator, &SimulatorConfig::tick_size, kPositive),
+            field("simulator.depth_levels", &E::simulator, &SimulatorConfig::depth_levels, kAtLeastOne),
+            field("simulator.seed", &E::simulator, &SimulatorConfig::seed),
+            field("simulator.drift", &E::simulator, &SimulatorConfig::drift, kAny),
+            field("simulator.volatility", &E::simulator, &SimulatorConfig::volatility, kNonNegative),
+            field("simulator.jump_intensity", &E::simulator, &SimulatorConfig::jump_intensity, kNonNegative),
+            field("simulator.jump_mean", &E::simulator, &SimulatorConfig::jump_mean),
+            field("simulator.jump_stddev", &E::simulator, &SimulatorConfig::jump_stddev, kNonNegative),
+            field("simulator.spread_mean_ticks", &E::simulator, &SimulatorConfig::spread_mean_ticks, kNonNegative),
+            field("simulator.spread_reversion", &E::simulator, &SimulatorConfig::spread_reversion, kNonNegative),
+            field("simulator.spread_volatility", &E::simulator, &SimulatorConfig::spread_volatility, kNonNegative),
+            field("simulator.hawkes_base_rate", &E::simulator, &SimulatorConfig::hawkes_base_rate, kPositive),
+            field("simulator.hawkes_excitation", &E::simulator, &SimulatorConfig::hawkes_excitation, kNonNegative),
+            field("simulator.hawkes_decay", &E::simulator, &SimulatorConfig::hawkes_decay, kPositive),
+            field("simulator.add_probability", &E::simulator, &SimulatorConfig::add_probability, kProbability),
+            field("simulator.cancel_probability", &E::simulator, &SimulatorConfig::cancel_probability, kProbability),
+            field("simulator.mean_order_size", &E::simulator, &SimulatorConfig::mean_order_size, kPositive),
+            field("simulator.basis_reversion", &E::simulator, &SimulatorConfig::basis_reversion, kNonNegative),
+            field("simulator.basis_volatility", &E::simulator, &SimulatorConfig::basis_volatility, kNonNegative),
+            field("simulator.dislocation_intensity", &E::simulator, &SimulatorConfig::dislocation_intensity, kNonNegative),
+            field("simulator.dislocation_stddev", &E::simulator, &SimulatorConfig::dislocation_stddev, kNonNegative),
+
+            field("execution.order_latency_us", &E::execution, &ExecutionConfig::order_latency_us, kNonNegative),
+            field("execution.fill_probability", &E::execution, &ExecutionConfig::fill_probability, kProbability),
+            field("execution.resting_fill_probability", &E::execution, &ExecutionConfig::resting_fill_probability, kProbability),
+            field("execution.resting_ttl_ms", &E::execution, &ExecutionConfig::resting_ttl_ms, kNonNegative),
+            field("execution.passive_fill_decay", &E::execution, &ExecutionConfig::passive_fill_decay, kNonNegative),
+
+            field("risk.max_position", &E::risk, &RiskLimits::max_position, kNonNegative),
+            field("risk.daily_loss_limit", &E::risk, &RiskLimits::daily_loss_limit, kNonPositive),
+            field("risk.max_order_quantity", &E::risk, &RiskLimits::max_order_quantity, kNonNegative),
+            field("risk.price_band", &E::risk, &RiskLimits::price_band, kNonNegative),
+            field("risk.max_net_notional", &E::risk, &RiskLimits::max_net_notional, kNonNegative),
+            field("risk.max_gross_notional", &E::risk, &RiskLimits::max_gross_notional, kNonNegative),
+            field("risk.symbol_max_position", &E::risk, &RiskLimits::symbol_max_position, kNonNegative),
+            field("risk.strategy_max_position", &E::risk, &RiskLimits::strategy_max_position, kNonNegative),
+            field("risk.strategy_order_rate", &E::risk, &RiskLimits::strategy_order_rate, kNonNegative),
+            field("risk.strategy_order_burst", &E::risk, &RiskLimits::strategy_order_burst, kAtLeastOne),
+            field("risk.symbol_order_rate", &E::risk, &RiskLimits::symbol_order_rate, kNonNegative),
+            field("risk.symbol_order_burst", &E::risk, &RiskLimits::symbol_order_burst, kAtLeastOne),
+
+            field("breakers.halt_on_loss_limit", &E::breakers, &CircuitBreakerConfig::halt_on_loss_limit),
+            field("breakers.halt_on_position_breach", &E::breakers, &CircuitBreakerConfig::halt_on_position_breach),
+            field("breakers.max_tick_latency_ms", &E::breakers, &CircuitBreakerConfig::max_tick_latency_ms, kNonNegative),
+            field("breakers.latency_breach_ticks", &E::breakers, &CircuitBreakerConfig::latency_breach_ticks, kAtLeastOne),
+
+            field("market_making.enabled", &E::market_making, &MarketMakingConfig::enabled),
+            field("market_making.risk_aversion", &E::market_making, &MarketMakingConfig::risk_aversion, kPositive),
+            field("market_making.liquidity", &E::market_making, &MarketMakingConfig::liquidity, kPositive),
+            field("market_making.horizon_ticks", &E::market_making, &MarketMakingConfig::horizon_ticks, kNonNegative),
+            field("market_making.volatility_halflife", &E::market_making, &MarketMakingConfig::volatility_halflife, kPositive),
+            field("market_making.quote_size", &E::market_making, &MarketMakingConfig::quote_size, kNonNegative),
+            field("market_making.position_limit", &E::market_making, &MarketMakingConfig::position_limit, kNonNegative),
+            field("market_making.tick_size", &E::market_making, &MarketMakingConfig::tick_size, kPositive),
+
+            field("arbitrage.enabled", &E::arbitrage, &ArbitrageConfig::enabled),
+            field("arbitrage.min_profit", &E::arbitrage, &ArbitrageConfig::min_profit, kNonNegative),
+            field("arbitrage.quantity", &E::arbitrage, &ArbitrageConfig::quantity, kPositive),
+
+            field("momentum.enabled", &E::momentum, &MomentumConfig::enabled),
+            field("momentum.fast_period", &E::momentum, &MomentumConfig::fast_period, kAtLeastOne),
+            field("momentum.slow_period", &E::momentum, &MomentumConfig::slow_period, kAtLeastOne),
+            field("momentum.quantity", &E::momentum, &MomentumConfig::quantity, kPositive),
+
+            field("mean_reversion.enabled", &E::mean_reversion, &MeanReversionConfig::enabled),
+            field("mean_reversion.window", &E::mean_reversion, &MeanReversionConfig::window, Range{2.0, HUGE_VAL, false}),
+            field("mean_reversion.entry_z", &E::mean_reversion, &MeanReversionConfig::entry_z, kNonNegative),
+            field("mean_reversion.exit_z", &E::mean_reversion, &MeanReversionConfig::exit_z, kNonNegative),
+            field("mean_reversion.quantity", &E::mean_reversion, &MeanReversionConfig::quantity, kPositive),
+
+            field("cross_venue.enabled", &E::cross_venue, &CrossVenueConfig::enabled),
+            field("cross_venue.min_edge", &E::cross_venue, &CrossVenueConfig::min_edge, kNonNegative),
+            field("cross_venue.max_quantity", &E::cross_venue, &CrossVenueConfig::max_quantity, kPositive),
+
+            field("triangular.enabled", &E::triangular, &TriangularConfig::enabled),
+            field("triangular.min_return", &E::triangular, &TriangularConfig::min_return, kNonNegative),
+            field("triangular.quantity", &E::triangular, &TriangularConfig::quantity, kPositive),
+            field("triangular.max_cycle_length", &E::triangular, &TriangularConfig::max_cycle_length, Range{3.0, HUGE_VAL, false}),
+        };
+        return table;
+    }
+};
+
+// Per-stage throughput and backlog counters
+struct EngineStats {
+    uint64_t ticks_published;
+    uint64_t ticks_dropped;
+    uint64_t ticks_conflated;
+    uint64_t ticks_processed;
+    uint64_t orders_sent;
+    uint64_t orders_processed;
+    uint64_t orders_filled;
+    uint64_t orders_mass_cancelled;
+    size_t live_orders;
+    size_t market_data_depth;
+    size_t market_data_high_water;
+    size_t order_depth;
+    size_t order_high_water;
+};
+
+// Screen Buffer - one terminal frame built in a reused buffer and sent
+// with a single write(). A frame starts at the cursor home position and
+// every line clears to its end, so it overwrites the previous frame in
+// place: no shell, no full-screen clear, no flicker.
+class ScreenBuffer {
+public:
+    static constexpr const char* kReset = "\x1b[0m";
+    static constexpr const char* kBold = "\x1b[1m";
+    static constexpr const char* kRed = "\x1b[31m";
+    static constexpr const char* kGreen = "\x1b[32m";
+    static constexpr const char* kYellow = "\x1b[33m";
+
+private:
+    std::vector<char> data_;
+    size_t size_ = 0;
+
+public:
+    explicit ScreenBuffer(size_t capacity = 16384) : data_(capacity) {}
+
+    void begin() {
+        size_ = 0;
+        append("\x1b[H");
+    }
+
+    ScreenBuffer& append(const char* text) { return write(text, std::strlen(text)); }
+    ScreenBuffer& append(const std::string& text) { return write(text.data(), text.size()); }
+
+    __attribute__((format(printf, 2, 3)))
+    ScreenBuffer& format(const char* fmt, ...) {
+        while (true) {
+            va_list args;
+            va_start(args, fmt);
+            int n = std::vsnprintf(data_.data() + size_, data_.size() - size_, fmt, args);
+            va_end(args);
+            if (n < 0) return *this;
+            if (size_ + static_cast<size_t>(n) < data_.size()) {
+                size_ += static_cast<size_t>(n);
+                return *this;
+            }
+            data_.resize(std::max(data_.size() * 2, size_ + static_cast<size_t>(n) + 1));
+        }
+    }
+
+    // Text in an SGR color, then back to normal
+    ScreenBuffer& color(const char* sgr, const char* text) { return append(sgr).append(text).append(kReset); }
+
+    ScreenBuffer& endLine() { return append("\x1b[K\n"); }
+
+    // Clears below the frame and writes it out; false if the terminal went away
+    bool flush(int fd) {
+        append("\x1b[J");
+        size_t written = 0;
+        while (written < size_) {
+            ssize_t n = ::write(fd, data_.data() + written, size_ - written);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) return false;
+            written += static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+private:
+    ScreenBuffer& write(const char* text, size_t length) {
+        if (size_ + length > data_.size()) data_.resize(std::max(data_.size() * 2, size_ + length));
+        std::memcpy(data_.data() + size_, text, length);
+        size_ += length;
+        return *this;
+    }
+};
+
+// Main HFT Engine
+class HFTEngine {
+private:
+    static constexpr size_t kPluginsIndex = 6;
+
+    EngineOptions options_;
+    std::atomic<bool> running_;
+    std::vector<std::unique_ptr<TradingStrategy>> strategies_;
+    std::unique_ptr<RiskManager> risk_manager_;
+    std::unique_ptr<PnlEngine> pnl_engine_;
+    std::vector<std::unique_ptr<MarketDataFeed>> market_feeds_;   // one per venue
+    std::unique_ptr<OrderManager> order_manager_;
+    VenueBooks books_;
+    Symbol display_symbol_;
+    KillSwitch kill_switch_;
+    LiveParams<CircuitBreakerConfig> breakers_;
+    std::mutex parameter_mutex_;                // guards parameters_
+    EngineOptions parameters_;                  // live-updatable options as last set
+    
+    ThreadSafeQueue<MarketData> market_data_queue_;
+    ThreadSafeQueue<Order> order_queue_;
+    TickConflator tick_conflator_;
+    BroadcastRing<MarketData> broadcast_ring_;
+    size_t engine_consumer_ = 0;
+    size_t ui_consumer_ = 0;
+    EventPipeline pipeline_;
+    std::unique_ptr<MarketDataSink> queue_sink_;
+    std::unique_ptr<MarketDataSink> venue_sink_;
+    std::unique_ptr<ShmServer> shm_server_;
+    
+    std::thread engine_thread_;
+    std::vector<std::thread> stage_threads_;
+    std::thread ui_thread_;
+
+    std::atomic<uint64_t> ticks_processed_{0};
+    std::atomic<uint64_t> orders_sent_{0};
+    std::atomic<uint64_t> pipeline_orders_dropped_{0};   // strategy outputs that didn't fit an event
+    FastRng book_rng_{std::random_device{}()};  // engine thread only
+    int slow_ticks_ = 0;                        // engine thread only
+
+    // Batch draining (engine thread only)
+    static constexpr size_t kMinBatch = 16;
+    size_t batch_limit_ = kMinBatch;
+    std::vector<MarketData> batch_;
+    std::vector<MarketData> latest_ticks_;
+    std::vector<uint32_t> batch_slot_ = std::vector<uint32_t>(ConflationKey<MarketData>::kKeySpace, 0);
+    std::atomic<uint64_t> ticks_coalesced_{0};
+    std::vector<ScreenedStrategy*> screened_;   // parallel to strategies_, null if not screened
+    std::vector<uint64_t> signal_mask_ = std::vector<uint64_t>(SymbolTable::kMaxSymbols / 64);
+
+public:
+    HFTEngine(const EngineOptions& options = EngineOptions()) 
+        : options_(options), running_(false), breakers_(options.breakers), parameters_(options),
+          market_data_queue_(options_.market_data_queue.capacity, options_.market_data_queue.policy),
+          order_queue_(options_.order_queue.capacity, options_.order_queue.policy),
+          broadcast_ring_(options_.market_data_path == MarketDataPath::BROADCAST
+                              ? std::max<size_t>(options_.market_data_queue.capacity, 1024) : 1,
+                          options_.broadcast_max_stall),
+          pipeline_(options_.market_data_path == MarketDataPath::PIPELINE ? options_.pipeline_capacity : 1) {
+        // Initialize strategies
+        const auto& momentum = options_.momentum;
+        const auto& mean_reversion = options_.mean_reversion;
+        const auto& triangular_config = options_.triangular;
+        strategies_.push_back(std::make_unique<MarketMakingStrategy>(options_.market_making));
+        strategies_.push_back(std::make_unique<ArbitrageStrategy>(options_.arbitrage.min_profit,
+                                                                  options_.arbitrage.quantity));
+        strategies_.push_back(std::make_unique<MomentumStrategy>(momentum.fast_period, momentum.slow_period,
+                                                                 momentum.quantity));
+        strategies_.push_back(std::make_unique<MeanReversionStrategy>(mean_reversion.window, mean_reversion.entry_z,
+                                                                      mean_reversion.exit_z, mean_reversion.quantity));
+        strategies_.push_back(std::make_unique<CrossVenueArbitrageStrategy>(options_.cross_venue.min_edge,
+                                                                            options_.cross_venue.max_quantity));
+        auto triangular = std::make_unique<TriangularArbitrageStrategy>(
+            options_.simulator.symbols, triangular_config.min_return, triangular_config.quantity,
+            triangular_config.max_cycle_length);
+        triangular->setActive(triangular_config.enabled && triangular->cycleCount() > 0);
+        strategies_.push_back(std::move(triangular));
+        strategies_.push_back(std::make_unique<PluginStrategy>());
+        strategies_[0]->setActive(options_.market_making.enabled);
+        strategies_[1]->setActive(options_.arbitrage.enabled);
+        strategies_[2]->setActive(momentum.enabled);
+        strategies_[3]->setActive(mean_reversion.enabled);
+        strategies_[4]->setActive(options_.cross_venue.enabled && options_.venues > 1);
+        for (auto& strategy : strategies_) {
+            screened_.push_back(dynamic_cast<ScreenedStrategy*>(strategy.get()));
+        }
+        
+        // Initialize components
+        pnl_engine_ = std::make_unique<PnlEngine>();
+        risk_manager_ = std::make_unique<RiskManager>(options_.risk);
+        risk_manager_->setPnlSource(pnl_engine_.get());
+        auto* market_maker = static_cast<MarketMakingStrategy*>(strategies_[0].get());
+        market_maker->setPositionSource(pnl_engine_.get());
+        market_maker->quoteManager().enableTracking();
+        for (const auto& instrument : options_.simulator.instruments) {
+            if (instrument.tick_size > 0.0) market_maker->setTickSize(Symbol(instrument.symbol), instrument.tick_size);
+        }
+        if (options_.market_data_path == MarketDataPath::BROADCAST) {
+            engine_consumer_ = broadcast_ring_.addConsumer(ConsumerMode::GATING);
+            ui_consumer_ = broadcast_ring_.addConsumer(ConsumerMode::LAPPED);
+            queue_sink_ = std::make_unique<BroadcastMarketDataSink>(broadcast_ring_);
+        } else if (options_.market_data_path == MarketDataPath::PIPELINE) {
+            queue_sink_ = std::make_unique<PipelineMarketDataSink>(pipeline_);
+        } else {
+            queue_sink_ = std::make_unique<QueueMarketDataSink>(market_data_queue_);
+        }
+        MarketDataSink* sink = options_.market_data_path == MarketDataPath::CONFLATED
+                                   ? static_cast<MarketDataSink*>(&tick_conflator_)
+                                   : queue_sink_.get();
+        createVenueFeeds(*sink);
+        order_manager_ = std::make_unique<OrderManager>(order_queue_, &kill_switch_, options_.execution);
+        order_manager_->setReferencePrices(risk_manager_.get());
+        order_manager_->addListener(risk_manager_.get());
+        order_manager_->addListener(pnl_engine_.get());
+        order_manager_->addListener(&market_maker->quoteManager());
+        if (!options_.shm_name.empty()) {
+            shm_server_ = std::make_unique<ShmServer>(options_.shm_name);
+        }
+    }
+
+    void start() {
+        running_ = true;
+        
+        // Start all components
+        const ThreadPlacement& cpus = options_.threads;
+        for (size_t venue = 0; venue < market_feeds_.size(); ++venue) {
+            market_feeds_[venue]->start(cpus.feed < 0 ? -1 : cpus.feed + static_cast<int>(venue));
+        }
+        order_manager_->start(cpus.orders);
+        
+        // Start main engine loop
+        if (options_.market_data_path == MarketDataPath::CONFLATED) {
+            engine_thread_ = std::thread(&HFTEngine::conflatedEngineLoop, this);
+        } else if (options_.market_data_path == MarketDataPath::BROADCAST) {
+            engine_thread_ = std::thread(&HFTEngine::broadcastEngineLoop, this);
+        } else if (options_.market_data_path == MarketDataPath::PIPELINE) {
+            startPipeline();
+        } else {
+            engine_thread_ = std::thread(&HFTEngine::engineLoop, this);
+        }
+        pinThread(engine_thread_, cpus.engine, "engine");
+        for (size_t stage = 0; stage < stage_threads_.size(); ++stage) {
+            pinThread(stage_threads_[stage], cpus.engine < 0 ? -1 : cpus.engine + static_cast<int>(stage),
+                      "pipeline stage");
+        }
+        
+        // Start UI thread
+        if (options_.show_ui) {
+            ui_thread_ = std::thread(&HFTEngine::uiLoop, this);
+            pinThread(ui_thread_, cpus.ui, "UI");
+        }
+        
+        std::cout << "HFT Engine started successfully!" << std::endl;
+    }
+
+    void stop() {
+        running_ = false;
+        
+        // Release any producer blocked on a full queue
+        market_data_queue_.close();
+        order_queue_.close();
+        pipeline_.close();
+        
+        for (auto& feed : market_feeds_) feed->stop();
+        order_manager_->stop();
+        
         if (engine_thread_.joinable()) {
             engine_thread_.join();
         }
+        for (auto& thread : stage_threads_) thread.join();
+        stage_threads_.clear();
         if (ui_thread_.joinable()) {
             ui_thread_.join();
         }
@@ -501,94 +5200,956 @@ public:
         }
     }
 
+    // Operator kill switch: strategies stop at the next tick and the order
+    // manager cancels everything queued or resting
+    bool halt(HaltReason reason = HaltReason::OPERATOR) {
+        bool tripped = kill_switch_.trip(reason);
+        if (tripped) {
+            std::cout << "TRADING HALTED (" << haltReasonName(reason) << ")" << std::endl;
+        }
+        return tripped;
+    }
+
+    bool resume() {
+        slow_ticks_ = 0;
+        bool resumed = kill_switch_.reset();
+        if (resumed) std::cout << "Trading resumed" << std::endl;
+        return resumed;
+    }
+
+    bool isHalted() const { return kill_switch_.halted(); }
+
+    // Operator thread: changes a strategy, risk or breaker option while
+    // trading ("section.key=value", as in the config file). The new values
+    // are published as a fresh block that the engine picks up at its next
+    // tick; other sections only take effect at startup.
+    void setParameter(const std::string& assignment) {
+        std::lock_guard<std::mutex> lock(parameter_mutex_);
+        EngineOptions updated = parameters_;
+        EngineConfig::set(updated, assignment);
+        std::string key = assignment.substr(0, assignment.find('='));
+        key.erase(std::remove_if(key.begin(), key.end(), [](char c) { return c == ' ' || c == '\t'; }), key.end());
+        const std::string section = key.substr(0, key.find('.'));
+        const bool enable = key == section + ".enabled";
+
+        if (section == "risk") {
+            risk_manager_->updateLimits(updated.risk);
+        } else if (section == "breakers") {
+            breakers_.publish(updated.breakers);
+        } else if (section == "market_making") {
+            static_cast<MarketMakingStrategy*>(strategies_[0].get())->updateConfig(updated.market_making);
+            if (enable) strategies_[0]->setActive(updated.market_making.enabled);
+        } else if (section == "arbitrage") {
+            static_cast<ArbitrageStrategy*>(strategies_[1].get())->updateConfig(updated.arbitrage);
+            if (enable) strategies_[1]->setActive(updated.arbitrage.enabled);
+        } else if (section == "momentum") {
+            static_cast<MomentumStrategy*>(strategies_[2].get())->updateConfig(updated.momentum);
+            if (enable) strategies_[2]->setActive(updated.momentum.enabled);
+        } else if (section == "mean_reversion") {
+            static_cast<MeanReversionStrategy*>(strategies_[3].get())->updateConfig(updated.mean_reversion);
+            if (enable) strategies_[3]->setActive(updated.mean_reversion.enabled);
+        } else if (section == "cross_venue") {
+            static_cast<CrossVenueArbitrageStrategy*>(strategies_[4].get())->updateConfig(updated.cross_venue);
+            if (enable) strategies_[4]->setActive(updated.cross_venue.enabled && options_.venues > 1);
+        } else if (section == "triangular") {
+            auto* triangular = static_cast<TriangularArbitrageStrategy*>(strategies_[5].get());
+            triangular->updateConfig(updated.triangular);
+            if (enable) triangular->setActive(updated.triangular.enabled && triangular->cycleCount() > 0);
+        } else {
+            throw std::invalid_argument("HFTEngine: " + key + " only takes effect at startup");
+        }
+        parameters_ = updated;
+        std::cout << "Set " << key << " (live at next tick)" << std::endl;
+    }
+
+    // Loads a strategy plugin and stages its strategies; they go live on the
+    // next tick, replacing (and taking the state of) same-named strategies
+    void loadPlugin(const std::string& path, const std::string& config = std::string()) {
+        auto start = std::chrono::steady_clock::now();
+        PluginLibrary library(path);
+        auto* plugins = static_cast<PluginStrategy*>(strategies_[kPluginsIndex].get());
+        plugins->deploy(library, config);
+        plugins->setActive(true);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "Loaded " << path << " in " << std::fixed << std::setprecision(2) << ms << " ms:";
+        for (const auto* factory : library.factories()) std::cout << " " << factory->name;
+        std::cout << " (live at next tick)" << std::endl;
+    }
+
+    void unloadPlugin(const std::string& name) {
+        static_cast<PluginStrategy*>(strategies_[kPluginsIndex].get())->undeploy(name);
+        std::cout << "Unloading " << name << " at next tick" << std::endl;
+    }
+
+    EngineStats getStats() const {
+        uint64_t published = 0, dropped = 0;
+        for (const auto& feed : market_feeds_) {
+            published += feed->getStats().published.load(std::memory_order_relaxed);
+            dropped += feed->getStats().dropped.load(std::memory_order_relaxed);
+        }
+        // Feeds count ticks their sink refused, the queue the ones it evicted
+        EngineStats stats{
+            published,
+            dropped + market_data_queue_.droppedCount(),
+            market_data_queue_.conflatedCount(),
+            ticks_processed_.load(std::memory_order_relaxed),
+            orders_sent_.load(std::memory_order_relaxed),
+            order_manager_->getProcessedCount(),
+            order_manager_->getFilledCount(),
+            order_manager_->getMassCancelledCount(),
+            order_manager_->getLiveOrderCount(),
+            market_data_queue_.size(),
+            market_data_queue_.highWaterMark(),
+            order_queue_.size(),
+            order_queue_.highWaterMark()};
+        stats.ticks_conflated += ticks_coalesced_.load(std::memory_order_relaxed);
+        if (options_.market_data_path == MarketDataPath::CONFLATED) {
+            stats.ticks_conflated += tick_conflator_.conflatedCount();
+            stats.market_data_depth = tick_conflator_.pendingCount();
+        } else if (options_.market_data_path == MarketDataPath::BROADCAST) {
+            stats.ticks_dropped += broadcast_ring_.lappedCount(engine_consumer_);
+            stats.market_data_depth = broadcast_ring_.lag(engine_consumer_);
+            stats.market_data_high_water = broadcast_ring_.maxLag(engine_consumer_);
+        } else if (options_.market_data_path == MarketDataPath::PIPELINE) {
+            stats.market_data_depth = pipeline_.lag(STAGE_DISPATCH);
+        }
+        return stats;
+    }
+
 private:
+    // Venue 0 runs the configured simulator; every other venue gets its own
+    // feed anchored to venue 0's price. Each (venue, symbol) has a book.
+    void createVenueFeeds(MarketDataSink& sink) {
+        const size_t venues = options_.venues;
+        if (venues == 0 || venues > kMaxVenues) {
+            throw std::invalid_argument("HFTEngine: venues must be 1.." + std::to_string(kMaxVenues));
+        }
+        if (venues > 1 && options_.market_data_path == MarketDataPath::CONFLATED) {
+            throw std::invalid_argument("HFTEngine: the CONFLATED path keys ticks by symbol only; use one venue");
+        }
+        MarketDataSink* shared = &sink;
+        if (venues > 1 && (options_.market_data_path == MarketDataPath::BROADCAST ||
+                           options_.market_data_path == MarketDataPath::PIPELINE)) {
+            venue_sink_ = std::make_unique<SerializedMarketDataSink>(sink);
+            shared = venue_sink_.get();
+        }
+        auto anchor = venues > 1 ? std::make_shared<VenueAnchor>() : nullptr;
+        for (size_t venue = 0; venue < venues; ++venue) {
+            SimulatorConfig config = options_.simulator;
+            config.venue = static_cast<VenueId>(venue);
+            config.anchor = anchor;
+            if (config.seed) config.seed += venue;
+            for (const auto& name : config.symbols) books_.add(config.venue, Symbol(name), config.tickSizeOf(name));
+            market_feeds_.push_back(std::make_unique<MarketDataFeed>(*shared, config, options_.feed));
+        }
+        display_symbol_ = Symbol(options_.simulator.symbols.front());
+    }
+
     void engineLoop() {
         while (running_) {
-            MarketData data{"", 0, 0, 0, 0};
-            if (market_data_queue_.pop(data)) {
-                // Update order book
-                updateOrderBook(data);
+            if (kill_switch_.halted()) {
+                haltedWait();
+                continue;
+            }
+            batch_.clear();
+            size_t count = market_data_queue_.popBatch(batch_, std::min(batch_limit_, options_.max_batch));
+            if (count > 0) {
+                {
+                    EpochGuard guard;   // one announcement per batch, not per tick
+                    processBatch();
+                }
+                adaptBatchLimit(count);
+            } else {
+                pnl_engine_->processFills();
+                drainClientOrders();
+            }
+        }
+    }
+
+    // Each tick replaces its venue's book and quote for the symbol, so within
+    // a batch only the last tick per (venue, symbol) is evaluated; earlier
+    // ones are folded into it
+    void processBatch() {
+        if (batch_.size() == 1) {
+            processMarketData(batch_[0]);
+            return;
+        }
+        latest_ticks_.clear();
+        for (const auto& tick : batch_) {
+            uint32_t& slot = batch_slot_[ConflationKey<MarketData>::get(tick)];
+            if (slot == 0) {
+                latest_ticks_.push_back(tick);
+                slot = static_cast<uint32_t>(latest_ticks_.size());
+            } else {
+                latest_ticks_[slot - 1] = tick;
+            }
+        }
+        bool screen = options_.batched_signals;
+        for (const auto& tick : latest_ticks_) {
+            batch_slot_[ConflationKey<MarketData>::get(tick)] = 0;
+            processMarketData(tick, screen);
+        }
+        if (screen) runScreenedStrategies();
+        uint64_t coalesced = batch_.size() - latest_ticks_.size();
+        ticks_coalesced_.fetch_add(coalesced, std::memory_order_relaxed);
+        ticks_processed_.fetch_add(coalesced, std::memory_order_relaxed);
+    }
+
+    // Grow the batch while the queue keeps filling it, shrink once it doesn't
+    void adaptBatchLimit(size_t count) {
+        if (count == batch_limit_) {
+            batch_limit_ = std::min(batch_limit_ * 2, std::max<size_t>(options_.max_batch, 1));
+        } else if (count < batch_limit_ / 4) {
+            batch_limit_ = std::max(batch_limit_ / 2, kMinBatch);
+        }
+    }
+
+    // Consumes the conflation stage: one pass per cycle over changed symbols
+    void conflatedEngineLoop() {
+        while (running_) {
+            if (kill_switch_.halted()) {
+                haltedWait();
+                continue;
+            }
+            size_t visited;
+            {
+                EpochGuard guard;
+                visited = tick_conflator_.drain([this](const MarketData& data) {
+                    processMarketData(data);
+                });
+            }
+            if (visited == 0) {
+                pnl_engine_->processFills();
+                drainClientOrders();
+                tick_conflator_.waitForData(std::chrono::milliseconds(100));
+            }
+        }
+    }
+
+    // While halted the feed backs up into its queue or conflation slots;
+    // fills from the mass cancel still have to reach the P&L engine
+    void haltedWait() {
+        if (options_.market_data_path == MarketDataPath::BROADCAST) {
+            broadcast_ring_.skip(engine_consumer_);     // stay gating, don't get isolated
+        }
+        pnl_engine_->processFills();
+        drainClientOrders();
+        risk_manager_->aggregate();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    // Gating consumer of the broadcast ring; reads ticks in place of a queue
+    void broadcastEngineLoop() {
+        while (running_) {
+            if (kill_switch_.halted()) {
+                haltedWait();
+                continue;
+            }
+            size_t visited;
+            {
+                EpochGuard guard;
+                visited = broadcast_ring_.poll(engine_consumer_, [this](const MarketData& data) {
+                    processMarketData(data);
+                });
+            }
+            if (visited == 0) {
+                pnl_engine_->processFills();
+                drainClientOrders();
+                broadcast_ring_.waitForData(engine_consumer_, std::chrono::milliseconds(100));
+            }
+        }
+    }
+
+    // Evaluates each screened strategy's trigger for every symbol observed in
+    // the batch at once; only flagged symbols build orders
+    void runScreenedStrategies() {
+        EpochGuard guard;
+        for (size_t i = 0; i < strategies_.size(); ++i) {
+            ScreenedStrategy* strategy = screened_[i];
+            if (!strategy || !strategy->isActive()) continue;
+            size_t words = strategy->screen(signal_mask_.data());
+            for (size_t w = 0; w < words; ++w) {
+                for (uint64_t bits = signal_mask_[w]; bits; bits &= bits - 1) {
+                    size_t slot = w * 64 + static_cast<size_t>(__builtin_ctzll(bits));
+                    for (const auto& order : strategy->buildOrders(slot)) submitOrder(order);
+                }
+            }
+        }
+        risk_manager_->aggregate();
+    }
+
+    // With defer_screened, screened strategies only observe the tick and
+    // are evaluated for the whole batch by runScreenedStrategies()
+    void processMarketData(const MarketData& data, bool defer_screened = false) {
+        // Strategies, risk and breakers read live parameters. The engine loops
+        // hold a guard for the whole batch, so this nested one is a depth count
+        EpochGuard guard;
+        // Apply fills, update the venue's book, then re-mark positions on the
+        // new top (positions and risk are marked on the lead venue)
+        pnl_engine_->processFills();
+        OrderBook& book = updateOrderBook(data);
+        const bool lead = data.venue == kLeadVenue;
+        if (lead) {
+            auto [best_bid, best_ask] = book.getBestBidAsk();
+            risk_manager_->updateReferencePrice(data.symbol, 0.5 * (best_bid + best_ask));
+            pnl_engine_->onTopOfBook(data.symbol, best_bid, best_ask);
+        }
+        
+        // Generate trading signals from all active strategies
+        for (size_t i = 0; i < strategies_.size(); ++i) {
+            auto& strategy = strategies_[i];
+            if (strategy->isActive() && strategy->handlesVenue(data.venue)) {
+                if (defer_screened && screened_[i]) {
+                    screened_[i]->observe(data, book);
+                    continue;
+                }
+                auto orders = strategy->generateSignals(data, book);
                 
-                // Generate trading signals from all active strategies
+                for (const auto& order : orders) submitOrder(order);
+            }
+        }
+        if (shm_server_) {
+            if (lead) shm_server_->publish(data);
+            drainClientOrders();
+        }
+        risk_manager_->aggregate();
+        checkCircuitBreakers(data);
+        ticks_processed_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Caller holds an EpochGuard
+    void checkCircuitBreakers(const MarketData& data) {
+        const CircuitBreakerConfig& breakers = breakers_.read();
+        const RiskLimits& limits = risk_manager_->limits();
+        if (breakers.halt_on_loss_limit &&
+            risk_manager_->getCurrentPnL() < limits.daily_loss_limit) {
+            halt(HaltReason::LOSS_LIMIT);
+        }
+        if (breakers.halt_on_position_breach &&
+            std::abs(risk_manager_->getCurrentPosition()) > limits.max_position) {
+            halt(HaltReason::POSITION_BREACH);
+        }
+        if (breakers.max_tick_latency_ms > 0) {
+            double age_ms = std::chrono::duration<double, std::milli>(
+                std::chrono::high_resolution_clock::now() - data.timestamp).count();
+            slow_ticks_ = age_ms > breakers.max_tick_latency_ms ? slow_ticks_ + 1 : 0;
+            if (slow_ticks_ >= breakers.latency_breach_ticks) {
+                slow_ticks_ = 0;
+                halt(HaltReason::LATENCY);
+            }
+        }
+    }
+
+    // Staged pipeline: book, strategy, risk and dispatch each run on their
+    // own thread over the shared event ring, so a tick is never copied
+    // between stages. Strategies read the book stage's latest published
+    // snapshot; risk and P&L marks use the top of book stored in the event.
+    void startPipeline() {
+        stage_threads_.emplace_back([this] {
+            stageLoop(STAGE_BOOK, [this](PipelineEvent& event) {
+                event.top = updateOrderBook(event.tick).getTopOfBook();
+                // Single writer of the shared-memory ring on this path
+                if (shm_server_ && event.tick.venue == kLeadVenue) shm_server_->publish(event.tick);
+            }, [](size_t) {});
+        });
+        stage_threads_.emplace_back([this] {
+            stageLoop(STAGE_STRATEGY, [this](PipelineEvent& event) {
+                if (kill_switch_.halted()) return;
+                const OrderBook& book = books_.get(event.tick.venue, event.tick.symbol);
                 for (auto& strategy : strategies_) {
-                    if (strategy->isActive()) {
-                        auto orders = strategy->generateSignals(data, order_book_);
-                        
-                        for (const auto& order : orders) {
-                            // Risk check
-                            if (risk_manager_->checkOrder(order)) {
-                                order_queue_.push(order);
-                                risk_manager_->updatePosition(order);
-                            }
-                        }
+                    if (!strategy->isActive() || !strategy->handlesVenue(event.tick.venue)) continue;
+                    std::vector<Order> orders = strategy->generateSignals(event.tick, book);
+                    if (orders.size() > PipelineEvent::kMaxOrders - event.order_count) {
+                        // A quote manager that counted a dropped NEW as live
+                        // clears it when OrderManager cancels back its next AMEND
+                        pipeline_orders_dropped_.fetch_add(orders.size(), std::memory_order_relaxed);
+                        continue;
+                    }
+                    for (const auto& order : orders) event.orders[event.order_count++] = order;
+                }
+            }, [](size_t) {});
+        });
+        stage_threads_.emplace_back([this] {
+            stageLoop(STAGE_RISK, [this](PipelineEvent& event) {
+                const TopOfBook& top = event.top;
+                if (event.tick.venue == kLeadVenue) {
+                    risk_manager_->updateReferencePrice(event.tick.symbol, 0.5 * (top.bid + top.ask));
+                    pnl_engine_->onTopOfBook(event.tick.symbol, top.bid, top.ask);
+                }
+                for (size_t i = 0; i < event.order_count; ++i) {
+                    if (!kill_switch_.halted() && risk_manager_->reserveOrder(event.orders[i])) {
+                        event.approved |= uint32_t(1) << i;
+                    }
+                }
+                checkCircuitBreakers(event.tick);
+            }, [this](size_t) {
+                // Fills and the loss-limit aggregate are folded once per batch
+                pnl_engine_->processFills();
+                risk_manager_->aggregate();
+            });
+        });
+        stage_threads_.emplace_back([this] {
+            stageLoop(STAGE_DISPATCH, [this](PipelineEvent& event) {
+                // Refusals are reported from this stage only, so each
+                // strategy sees them from a single thread
+                for (size_t i = 0; i < event.order_count; ++i) {
+                    if (!(event.approved & (uint32_t(1) << i))) {
+                        refuseOrder(event.orders[i]);
+                    } else if (order_queue_.push(event.orders[i])) {
+                        orders_sent_.fetch_add(1, std::memory_order_relaxed);
+                    } else {
+                        risk_manager_->releaseOrder(event.orders[i]);
+                        refuseOrder(event.orders[i]);
                     }
                 }
+                ticks_processed_.fetch_add(1, std::memory_order_relaxed);
+            }, [this](size_t processed) {
+                if (processed == 0) drainClientOrders();
+            });
+        });
+    }
+
+    // Runs one stage until shutdown; after_batch(count) follows every pass.
+    // An idle stage backs off from spinning to yielding to short sleeps.
+    template<typename Fn, typename AfterBatch>
+    void stageLoop(PipelineStage stage, Fn&& fn, AfterBatch&& after_batch) {
+        int idle_passes = 0;
+        while (running_) {
+            size_t processed;
+            {
+                EpochGuard guard;
+                processed = pipeline_.process(stage, fn);
+                after_batch(processed);
+            }
+            if (processed > 0) {
+                idle_passes = 0;
+            } else if (++idle_passes > 256) {
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+            } else if (idle_passes > 64) {
+                std::this_thread::yield();
             }
         }
     }
 
-    void updateOrderBook(const MarketData& data) {
-        // Simulate order book updates
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::uniform_real_distribution<> size_dist(1.0, 50.0);
-        
-        for (int i = 0; i < 5; ++i) {
-            double bid_price = data.bid - (i * 0.01);
-            double ask_price = data.ask + (i * 0.01);
-            
-            order_book_.updateBid(bid_price, size_dist(gen));
-            order_book_.updateAsk(ask_price, size_dist(gen));
+    // Risk check, then hand to the order manager
+    void submitOrder(const Order& order) {
+        EpochGuard guard;
+        if (!risk_manager_->reserveOrder(order)) {
+            refuseOrder(order);
+            return;
         }
+        if (order_queue_.push(order)) {
+            orders_sent_.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            risk_manager_->releaseOrder(order);
+            refuseOrder(order);
+        }
+    }
+
+    // Lets the owning strategy roll back state it kept for a refused order
+    // (strategies_ is indexed by StrategyType)
+    void refuseOrder(const Order& order) {
+        size_t index = static_cast<size_t>(order.strategy);
+        if (index < strategies_.size()) strategies_[index]->onOrderRefused(order);
     }
 
+    // Orders from strategy processes take the same risk path; while halted
+    // they are discarded so nothing stale is sent after a resume
+    void drainClientOrders() {
+        if (!shm_server_) return;
+        shm_server_->pollOrders([this](const Order& order) {
+            if (!kill_switch_.halted()) submitOrder(order);
+        });
+    }
+
+    OrderBook& updateOrderBook(const MarketData& data) {
+        OrderBook& book = books_.get(data.venue, data.symbol);
+        applyTickToBook(book, data, book_rng_);
+        return book;
+    }
+
+    // Dashboard thread: redraws every ui_refresh_ms from atomics, seqlock
+    // book snapshots, published LiveParams blocks and its own lapped
+    // broadcast cursor, so it never takes a lock the trading threads use.
+    // Each frame is formatted into one reused buffer and sent in one write().
     void uiLoop() {
+        ScreenBuffer screen;
+        std::vector<std::string> names;                 // fixed once the engine is built
+        for (const auto& strategy : strategies_) names.push_back(strategy->getName());
+        const auto period = std::chrono::milliseconds(std::max<size_t>(options_.ui_refresh_ms, 10));
+        const auto step = std::min<std::chrono::steady_clock::duration>(period, std::chrono::milliseconds(50));
+
+        EngineStats last = getStats();
+        auto last_time = std::chrono::steady_clock::now();
+        screen.append("\x1b[2J");
         while (running_) {
-            std::this_thread::sleep_for(std::chrono::seconds(2));
-            
-            int result = system("clear");
-            (void)result; 
-            
-            std::cout << "=== HFT TRADING SYSTEM ===" << std::endl;
-            std::cout << "Status: " << (running_ ? "RUNNING" : "STOPPED") << std::endl;
-            std::cout << "Timestamp: " << std::chrono::duration_cast<std::chrono::seconds>(
-                std::chrono::high_resolution_clock::now().time_since_epoch()).count() << std::endl;
-            
-            // Strategy performance
-            std::cout << "\n=== STRATEGY PERFORMANCE ===" << std::endl;
-            for (size_t i = 0; i < strategies_.size(); ++i) {
-                const auto& strategy = strategies_[i];
-                std::cout << "[" << i << "] " << strategy->getName() 
-                         << " - Status: " << (strategy->isActive() ? "ACTIVE" : "INACTIVE")
-                         << " - P&L: $" << std::fixed << std::setprecision(2) << strategy->getPnL()
-                         << " - Trades: " << strategy->getTradeCount() << std::endl;
-            }
-            
-            // Risk metrics
-            std::cout << "\n=== RISK METRICS ===" << std::endl;
-            std::cout << "Current Position: " << risk_manager_->getCurrentPosition() << std::endl;
-            std::cout << "Current P&L: $" << std::fixed << std::setprecision(2) 
-                     << risk_manager_->getCurrentPnL() << std::endl;
-            
-            std::cout << "\n=== SYSTEM STATS ===" << std::endl;
-            std::cout << "Market Data Queue Size: " << market_data_queue_.size() << std::endl;
-            std::cout << "Order Queue Size: " << order_queue_.size() << std::endl;
-            std::cout << "Filled Orders: " << order_manager_->getFilledOrders().size() << std::endl;
-            
-            // Order book
-            order_book_.printOrderBook(3);
-            
-            std::cout << "\nCommands: [0-" << (strategies_.size()-1) << "] Toggle Strategy, [q] Quit" << std::endl;
+            // Sleep in short steps so stop() is not held up by a long period
+            const auto due = last_time + period;
+            while (running_ && std::chrono::steady_clock::now() < due) std::this_thread::sleep_for(step);
+            if (!running_) break;
+
+            const auto now = std::chrono::steady_clock::now();
+            const double seconds = std::chrono::duration<double>(now - last_time).count();
+            const EngineStats stats = getStats();
+            renderDashboard(screen, names, stats, last, seconds);
+            if (!screen.flush(STDOUT_FILENO)) break;
+            last = stats;
+            last_time = now;
+        }
+    }
+
+    void renderDashboard(ScreenBuffer& screen, const std::vector<std::string>& names,
+                         const EngineStats& stats, const EngineStats& last, double seconds) {
+        EpochGuard guard;   // plugin names are a LiveParams block
+        screen.begin();
+        screen.color(ScreenBuffer::kBold, "=== HFT TRADING SYSTEM ===").endLine();
+        screen.append("Status: ");
+        if (kill_switch_.halted()) {
+            screen.color(ScreenBuffer::kRed, "HALTED").format(" (%s)", haltReasonName(kill_switch_.reason()));
+        } else {
+            screen.color(ScreenBuffer::kGreen, "RUNNING");
+        }
+        screen.format(" - Halts: %llu - Timestamp: %lld", static_cast<unsigned long long>(kill_switch_.tripCount()),
+                      static_cast<long long>(std::chrono::duration_cast<std::chrono::seconds>(
+                          std::chrono::system_clock::now().time_since_epoch()).count())).endLine();
+        screen.format("Rates: feed %.0f/s - engine %.0f/s - orders %.0f/s - fills %.0f/s",
+                      (stats.ticks_published - last.ticks_published) / seconds,
+                      (stats.ticks_processed - last.ticks_processed) / seconds,
+                      (stats.orders_processed - last.orders_processed) / seconds,
+                      (stats.orders_filled - last.orders_filled) / seconds).endLine();
+
+        // Strategy performance
+        screen.endLine().color(ScreenBuffer::kBold, "=== STRATEGY PERFORMANCE ===").endLine();
+        for (size_t i = 0; i < strategies_.size(); ++i) {
+            const StrategyType type = strategies_[i]->getType();
+            const double pnl = pnl_engine_->getStrategyPnL(type);
+            screen.format("[%zu] %-16s ", i, names[i].c_str())
+                  .color(strategies_[i]->isActive() ? ScreenBuffer::kGreen : ScreenBuffer::kYellow,
+                         strategies_[i]->isActive() ? "ACTIVE  " : "INACTIVE")
+                  .append(" - P&L: ")
+                  .append(pnl < 0.0 ? ScreenBuffer::kRed : ScreenBuffer::kGreen)
+                  .format("$%.2f", pnl).append(ScreenBuffer::kReset)
+                  .format(" (realized %.2f) - Fills: %llu - Throttled: %llu", pnl_engine_->getRealizedPnL(type),
+                          static_cast<unsigned long long>(pnl_engine_->getFillCount(type)),
+                          static_cast<unsigned long long>(risk_manager_->getThrottledCount(type)))
+                  .endLine();
+        }
+
+        // Risk metrics
+        screen.endLine().color(ScreenBuffer::kBold, "=== RISK METRICS ===").endLine();
+        screen.format("Current Position: %.2f (in flight +%.2f / -%.2f)", risk_manager_->getCurrentPosition(),
+                      risk_manager_->getInFlightBuys(), risk_manager_->getInFlightSells()).endLine();
+        screen.format("Current P&L: $%.2f", risk_manager_->getCurrentPnL()).endLine();
+        for (uint32_t reason = 0; reason < kNumRiskRejects; ++reason) {
+            if (uint64_t count = risk_manager_->getRejectCount(reason)) {
+                screen.format("Rejected (%s): %llu", riskRejectName(reason),
+                              static_cast<unsigned long long>(count)).endLine();
+            }
+        }
+
+        screen.endLine().color(ScreenBuffer::kBold, "=== SYSTEM STATS ===").endLine();
+        screen.format("Ticks Published: %llu (dropped %llu, conflated %llu)",
+                      static_cast<unsigned long long>(stats.ticks_published),
+                      static_cast<unsigned long long>(stats.ticks_dropped),
+                      static_cast<unsigned long long>(stats.ticks_conflated)).endLine();
+        screen.format("Market Data Queue Size: %zu (high water %zu)", stats.market_data_depth,
+                      stats.market_data_high_water).endLine();
+        screen.format("Order Queue Size: %zu (high water %zu)", stats.order_depth, stats.order_high_water).endLine();
+        if (options_.market_data_path == MarketDataPath::PIPELINE) {
+            screen.format("Pipeline Backlog: book %zu, strategy %zu, risk %zu, dispatch %zu", pipeline_.lag(STAGE_BOOK),
+                          pipeline_.lag(STAGE_STRATEGY), pipeline_.lag(STAGE_RISK),
+                          pipeline_.lag(STAGE_DISPATCH)).endLine();
+            if (uint64_t dropped = pipeline_orders_dropped_.load(std::memory_order_relaxed)) {
+                screen.color(ScreenBuffer::kRed, "Pipeline Orders Dropped (event full): ")
+                      .format("%llu", static_cast<unsigned long long>(dropped)).endLine();
+            }
+        }
+        if (options_.market_data_path == MarketDataPath::BROADCAST) {
+            // Lapped consumer: reads the same slots as the engine
+            uint64_t seen = 0;
+            MarketData latest;
+            broadcast_ring_.poll(ui_consumer_, [&](const MarketData& data) {
+                ++seen;
+                latest = data;
+            }, SIZE_MAX);
+            bool gating = broadcast_ring_.isGating(engine_consumer_);
+            screen.append("Broadcast Ring: engine ")
+                  .color(gating ? ScreenBuffer::kGreen : ScreenBuffer::kRed, gating ? "gating" : "isolated")
+                  .format(" (isolated %llu, rejoined %llu), UI saw %llu ticks (lapped %llu)",
+                          static_cast<unsigned long long>(broadcast_ring_.isolatedCount()),
+                          static_cast<unsigned long long>(broadcast_ring_.rejoinedCount()),
+                          static_cast<unsigned long long>(seen),
+                          static_cast<unsigned long long>(broadcast_ring_.lappedCount(ui_consumer_)));
+            if (seen) screen.format(", last %s %.2f", latest.symbol.str().c_str(), latest.price);
+            screen.endLine();
+        }
+        if (shm_server_) {
+            screen.format("Strategy Clients: %zu (%s) | Rejected Orders: %llu", shm_server_->clientCount(),
+                          options_.shm_name.c_str(),
+                          static_cast<unsigned long long>(shm_server_->rejectedCount())).endLine();
+        }
+        screen.format("Filled Orders: %llu - Live: %zu - Mass Cancelled: %llu",
+                      static_cast<unsigned long long>(stats.orders_filled), stats.live_orders,
+                      static_cast<unsigned long long>(stats.orders_mass_cancelled)).endLine();
+        const QuoteManager& quotes = static_cast<MarketMakingStrategy*>(strategies_[0].get())->quoteManager();
+        screen.format("Quote Messages: new %llu, amend %llu, cancel %llu - Amended in place: %llu",
+                      static_cast<unsigned long long>(quotes.sentCount(OrderAction::NEW)),
+                      static_cast<unsigned long long>(quotes.sentCount(OrderAction::AMEND)),
+                      static_cast<unsigned long long>(quotes.sentCount(OrderAction::CANCEL)),
+                      static_cast<unsigned long long>(order_manager_->getAmendedCount())).endLine();
+
+        if (options_.venues > 1) {
+            auto* arbitrage = static_cast<const CrossVenueArbitrageStrategy*>(strategies_[4].get());
+            screen.format("Venues: %zu - %s bid/ask by venue:", options_.venues, display_symbol_.str().c_str());
+            for (size_t venue = 0; venue < options_.venues; ++venue) {
+                TopOfBook top = books_.get(static_cast<VenueId>(venue), display_symbol_).getTopOfBook();
+                screen.format(" [%zu] %.2f/%.2f", venue, top.bid, top.ask);
+            }
+            screen.format(" - Dislocations: %llu",
+                          static_cast<unsigned long long>(arbitrage->getDetectionCount())).endLine();
+        }
+
+        auto* triangular = static_cast<const TriangularArbitrageStrategy*>(strategies_[5].get());
+        if (triangular->cycleCount() > 0) {
+            screen.format("Triangular: %zu cycles - Dislocations: %llu", triangular->cycleCount(),
+                          static_cast<unsigned long long>(triangular->getDetectionCount())).endLine();
+        }
+
+        auto* plugins = static_cast<const PluginStrategy*>(strategies_[kPluginsIndex].get());
+        if (plugins->swapCount() > 0) {
+            screen.append("Plugins:");
+            const auto& deployed = plugins->deployedNames();
+            if (deployed.empty()) screen.append(" (none)");
+            for (const auto& name : deployed) screen.append(" ").append(name);
+            screen.format(" - Swaps: %llu (failed %llu, last %.2f us) - Rejected orders: %llu",
+                          static_cast<unsigned long long>(plugins->swapCount()),
+                          static_cast<unsigned long long>(plugins->failedCount()), plugins->lastSwapMicros(),
+                          static_cast<unsigned long long>(plugins->rejectedOrderCount())).endLine();
+        }
+
+        renderOrderBook(screen, books_.get(kLeadVenue, display_symbol_).getSnapshot(), 3);
+
+        screen.endLine().format("Commands: [0-%zu] Toggle Strategy, [k] Halt, [r] Resume, [p key=value] Set Parameter, "
+                                "[l path [config]] Load Plugin, [u name] Unload Plugin, [q] Quit",
+                                strategies_.size() - 1).endLine();
+    }
+
+    static void renderOrderBook(ScreenBuffer& screen, const BookSnapshot& book, int depth) {
+        screen.endLine().color(ScreenBuffer::kBold, "=== ORDER BOOK ===").endLine();
+        screen.append("ASK | Price  | Size").endLine();
+        for (int i = std::min(book.ask_levels, depth) - 1; i >= 0; --i) {
+            screen.format("    | %s%.2f%s | %.2f", ScreenBuffer::kRed, book.ask_price[i], ScreenBuffer::kReset,
+                          book.ask_quantity[i]).endLine();
         }
+        screen.append("----+--------+-----").endLine();
+        for (int i = 0; i < book.bid_levels && i < depth; ++i) {
+            screen.format("BID | %s%.2f%s | %.2f", ScreenBuffer::kGreen, book.bid_price[i], ScreenBuffer::kReset,
+                          book.bid_quantity[i]).endLine();
+        }
+        DepthAnalytics analytics = book.analytics(depth);
+        screen.format("Imbalance(%d): %.2f | Microprice: %.2f | Weighted Mid: %.2f", depth, analytics.imbalance,
+                      analytics.microprice, analytics.weighted_mid).endLine();
     }
 };
 
+// Simulator throughput benchmark: one independent simulator per thread,
+// each owning an equal share of the symbols
+void runSimulatorBenchmark(size_t num_symbols, double seconds, size_t num_threads) {
+    num_threads = std::max<size_t>(1, std::min(num_threads, num_symbols));
+    std::cout << "Simulating " << num_symbols << " symbols on " << num_threads
+              << " thread(s) for " << seconds << "s..." << std::endl;
+
+    std::vector<SimulatorConfig> configs(num_threads);
+    for (auto& config : configs) config.symbols.clear();
+    for (size_t i = 0; i < num_symbols; ++i) {
+        configs[i % num_threads].symbols.push_back("SIM" + std::to_string(i));
+    }
+
+    std::atomic<bool> running{true};
+    std::vector<uint64_t> counts(num_threads, 0);
+    std::vector<double> checksums(num_threads, 0.0);
+    std::vector<std::thread> threads;
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t t = 0; t < num_threads; ++t) {
+        configs[t].seed = t + 1;
+        threads.emplace_back([&, t] {
+            MarketSimulator simulator(configs[t]);
+            std::vector<BookEvent> events(4096);
+            uint64_t count = 0;
+            double checksum = 0.0;
+            while (running.load(std::memory_order_relaxed)) {
+                size_t n = simulator.generate(events.data(), events.size());
+                count += n;
+                checksum += events[n - 1].price;
+            }
+            counts[t] = count;
+            checksums[t] = checksum;
+        });
+    }
+
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+    running = false;
+    for (auto& thread : threads) thread.join();
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    uint64_t total = 0;
+    for (auto count : counts) total += count;
+    std::cout << "Generated " << total << " events in " << std::fixed << std::setprecision(2)
+              << elapsed << "s (" << (total / elapsed / 1e6) << "M events/sec)" << std::endl;
+}
+
+// Indicator self-check: drives RollingStats with a random walk (with
+// repeated values, so ties exercise the monotonic deques) and compares
+// min/max/mean/variance against a naive scan of the same window
+bool runIndicatorCheck(size_t updates) {
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<int> step(-2, 2);
+    size_t mismatches = 0;
+    for (size_t window : {2, 3, 5, 16, 100}) {
+        const size_t slots = 3;
+        RollingStats stats(slots, window);
+        std::vector<std::deque<double>> naive(slots);
+        std::vector<double> price(slots, 100.0);
+        for (size_t i = 0; i < updates; ++i) {
+            size_t slot = i % slots;
+            price[slot] += 0.01 * step(rng);
+            stats.update(slot, price[slot]);
+            naive[slot].push_back(price[slot]);
+            if (naive[slot].size() > window) naive[slot].pop_front();
+
+            const auto& samples = naive[slot];
+            double lo = *std::min_element(samples.begin(), samples.end());
+            double hi = *std::max_element(samples.begin(), samples.end());
+            double mean = std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
+            double m2 = 0.0;
+            for (double x : samples) m2 += (x - mean) * (x - mean);
+            double variance = samples.size() > 1 ? m2 / (samples.size() - 1) : 0.0;
+
+            if (stats.min(slot) != lo || stats.max(slot) != hi ||
+                std::abs(stats.mean(slot) - mean) > 1e-9 || std::abs(stats.variance(slot) - variance) > 1e-7) {
+                if (mismatches++ < 10) {
+                    std::cout << "window " << window << " update " << i << ": min " << stats.min(slot) << "/" << lo
+                              << " max " << stats.max(slot) << "/" << hi << " mean " << stats.mean(slot) << "/"
+                              << mean << " variance " << stats.variance(slot) << "/" << variance << std::endl;
+                }
+            }
+        }
+    }
+    std::cout << "RollingStats: " << mismatches << " mismatches against a naive window" << std::endl;
+    return mismatches == 0;
+}
+
+// Headless throughput run: prints per-stage rates, drops and queue
+// high-water marks once a second so each stage's saturation point shows up
+void runStressTest(const EngineOptions& options, double seconds) {
+    HFTEngine engine(options);
+    engine.start();
+
+    EngineStats last = engine.getStats();
+    auto last_time = std::chrono::steady_clock::now();
+    auto end_time = last_time + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(seconds));
+    double peak_feed = 0, peak_engine = 0, peak_orders = 0;
+
+    std::cout << std::fixed << std::setprecision(0);
+    while (std::chrono::steady_clock::now() < end_time) {
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+        auto now = std::chrono::steady_clock::now();
+        double dt = std::chrono::duration<double>(now - last_time).count();
+        EngineStats stats = engine.getStats();
+
+        double feed_rate = (stats.ticks_published - last.ticks_published) / dt;
+        double engine_rate = (stats.ticks_processed - last.ticks_processed) / dt;
+        double order_rate = (stats.orders_processed - last.orders_processed) / dt;
+        peak_feed = std::max(peak_feed, feed_rate);
+        peak_engine = std::max(peak_engine, engine_rate);
+        peak_orders = std::max(peak_orders, order_rate);
+
+        std::cout << "feed " << feed_rate << "/s (dropped " << stats.ticks_dropped
+                  << ", conflated " << stats.ticks_conflated << ")"
+                  << " | engine " << engine_rate << "/s"
+                  << " | orders " << order_rate << "/s"
+                  << " | md queue " << stats.market_data_depth << " (hwm " << stats.market_data_high_water << ")"
+                  << " | order queue " << stats.order_depth << " (hwm " << stats.order_high_water << ")"
+                  << std::endl;
+        last = stats;
+        last_time = now;
+    }
+
+    engine.stop();
+    std::cout << "Peak rates: feed " << peak_feed << "/s, engine " << peak_engine
+              << "/s, orders " << peak_orders << "/s" << std::endl;
+}
+
+// Out-of-process strategy: reads the engine's shared-memory market data,
+// keeps its own book and sends orders back through its client ring
+void runStrategyClient(const std::string& strategy_name, const std::string& shm_name, double seconds) {
+    ShmClient client(shm_name);
+    std::unique_ptr<TradingStrategy> strategy;
+    if (strategy_name == "arb") {
+        strategy = std::make_unique<ArbitrageStrategy>();
+    } else {
+        strategy = std::make_unique<MarketMakingStrategy>();
+    }
+    std::cout << strategy->getName() << " client attached to " << shm_name << std::endl;
+
+    OrderBook book;
+    FastRng rng(std::random_device{}());
+    uint64_t received = 0, sent = 0, rejected = 0;
+    auto end_time = std::chrono::steady_clock::now() +
+                    std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                        std::chrono::duration<double>(seconds));
+    auto next_report = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+
+    while (client.serverAlive()) {
+        MarketData data;
+        if (client.poll(data)) {
+            ++received;
+            EpochGuard guard;
+            applyTickToBook(book, data, rng);
+            for (const auto& order : strategy->generateSignals(data, book)) {
+                if (client.sendOrder(order)) ++sent; else ++rejected;
+            }
+            continue;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (now >= next_report) {
+            std::cout << "ticks " << received << " (lapped " << client.lappedCount() << ")"
+                      << " | orders sent " << sent << " (ring full " << rejected << ")" << std::endl;
+            next_report = now + std::chrono::seconds(1);
+            if (now >= end_time) break;
+        }
+        std::this_thread::yield();
+    }
+    if (!client.serverAlive()) std::cout << "Engine went away" << std::endl;
+}
+
+// Applies engine arguments from argv[first] on, in order, so later ones win:
+//   --config FILE       options file (see EngineConfig)
+//   --set KEY=VALUE     one option, e.g. --set risk.max_position=500
+//   --shm [name]        also serve market data to strategy client processes
+//   --venues [n]        n venue feeds with cross-venue arbitrage enabled
+//   --triangle          trade BTC/USD, ETH/USD and ETH/BTC with triangular arbitrage
+//   --print-config      print the resulting options and exit
+// Returns false if the caller should exit instead of running.
+bool applyEngineArguments(EngineOptions& options, int argc, char* argv[], int first) {
+    bool run = true;
+    for (int i = first; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc && argv[i + 1][0] != '-';
+        if (arg == "--config" || arg == "--set") {
+            if (!has_value) throw std::invalid_argument(arg + " needs a value");
+            if (arg == "--config") {
+                EngineConfig::loadFile(options, argv[++i]);
+            } else {
+                EngineConfig::set(options, argv[++i]);
+            }
+        } else if (arg == "--shm") {
+            options.shm_name = has_value ? argv[++i] : "/hft_engine";
+        } else if (arg == "--venues") {
+            options.venues = has_value ? std::stoul(argv[++i]) : 3;
+        } else if (arg == "--triangle") {
+            addTriangleUniverse(options.simulator);
+        } else if (arg == "--print-config") {
+            run = false;
+        } else {
+            throw std::invalid_argument("unknown argument " + arg);
+        }
+    }
+    EngineConfig::validate(options);
+    if (!run) EngineConfig::write(std::cout, options);
+    return run;
+}
+
 // Main function
-int main() {
+int main(int argc, char* argv[]) {
+    if (argc > 1 && std::string(argv[1]) == "--sim-bench") {
+        size_t symbols = argc > 2 ? std::stoul(argv[2]) : 1000;
+        double seconds = argc > 3 ? std::stod(argv[3]) : 5.0;
+        size_t threads = argc > 4 ? std::stoul(argv[4]) : std::thread::hardware_concurrency();
+        runSimulatorBenchmark(symbols, seconds, threads);
+        return 0;
+    }
+
+    if (argc > 1 && std::string(argv[1]) == "--check-indicators") {
+        return runIndicatorCheck(argc > 2 ? std::stoul(argv[2]) : 20000) ? 0 : 1;
+    }
+
+    if (argc > 1 && std::string(argv[1]) == "--stress") {
+        // --stress [rate|max] [seconds] [none|open|periodic]
+        //          [conflate|block|drop-oldest|drop-newest|unbounded|stage|broadcast|pipeline]
+        //          [venues] [engine arguments...]
+        int positional = 2;
+        while (positional < argc && argv[positional][0] != '-') ++positional;
+        EngineOptions options;
+        options.show_ui = false;
+        // Measure the pipeline, not the strategies: a breaker halt would
+        // stop the engine stage for the rest of the run
+        options.breakers.halt_on_loss_limit = false;
+        options.breakers.halt_on_position_breach = false;
+        options.breakers.max_tick_latency_ms = 0;
+        std::string rate = positional > 2 ? argv[2] : "max";
+        if (rate == "max") {
+            options.feed.mode = FeedMode::FIREHOSE;
+        } else {
+            options.feed.target_rate = std::stod(rate);
+        }
+        double seconds = positional > 3 ? std::stod(argv[3]) : 10.0;
+        std::string burst = positional > 4 ? argv[4] : "none";
+        if (burst == "open") options.feed.burst = BurstPattern::MARKET_OPEN;
+        if (burst == "periodic") options.feed.burst = BurstPattern::PERIODIC;
+        std::string policy = positional > 5 ? argv[5] : "conflate";
+        if (policy == "block") options.market_data_queue.policy = OverflowPolicy::BLOCK;
+        if (policy == "drop-oldest") options.market_data_queue.policy = OverflowPolicy::DROP_OLDEST;
+        if (policy == "drop-newest") options.market_data_queue.policy = OverflowPolicy::DROP_NEWEST;
+        if (policy == "unbounded") options.market_data_queue.capacity = 0;
+        if (policy == "stage") options.market_data_path = MarketDataPath::CONFLATED;
+        if (policy == "broadcast") options.market_data_path = MarketDataPath::BROADCAST;
+        if (policy == "pipeline") options.market_data_path = MarketDataPath::PIPELINE;
+        options.venues = positional > 6 ? std::stoul(argv[6]) : 1;
+        try {
+            if (!applyEngineArguments(options, argc, argv, positional)) return 0;
+            runStressTest(options, seconds);
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    if (argc > 1 && std::string(argv[1]) == "--strategy-client") {
+        // --strategy-client [mm|arb] [shm name] [seconds]
+        std::string strategy = argc > 2 ? argv[2] : "mm";
+        std::string name = argc > 3 ? argv[3] : "/hft_engine";
+        double seconds = argc > 4 ? std::stod(argv[4]) : 1e9;
+        try {
+            runStrategyClient(strategy, name, seconds);
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    EngineOptions options;
+    try {
+        if (!applyEngineArguments(options, argc, argv, 1)) return 0;
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
     std::cout << "Initializing HFT System..." << std::endl;
-    
-    HFTEngine engine;
-    engine.start();
+    std::unique_ptr<HFTEngine> engine_ptr;
+    try {
+        engine_ptr = std::make_unique<HFTEngine>(options);
+        engine_ptr->start();
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    HFTEngine& engine = *engine_ptr;
     
     char command;
     while (std::cin >> command) {
@@ -597,6 +6158,32 @@ int main() {
         } else if (command >= '0' && command <= '9') {
             int strategy_index = command - '0';
             engine.toggleStrategy(strategy_index);
+        } else if (command == 'k' || command == 'K') {
+            engine.halt();
+        } else if (command == 'r' || command == 'R') {
+            engine.resume();
+        } else if (command == 'l' || command == 'L') {
+            std::string path, config;
+            std::cin >> path;
+            std::getline(std::cin, config);
+            config.erase(0, config.find_first_not_of(" \t"));
+            try {
+                engine.loadPlugin(path, config);
+            } catch (const std::exception& e) {
+                std::cerr << e.what() << std::endl;
+            }
+        } else if (command == 'u' || command == 'U') {
+            std::string name;
+            std::cin >> name;
+            engine.unloadPlugin(name);
+        } else if (command == 'p' || command == 'P') {
+            std::string assignment;
+            std::cin >> assignment;
+            try {
+                engine.setParameter(assignment);
+            } catch (const std::exception& e) {
+                std::cerr << e.what() << std::endl;
+            }
         }
     }
     
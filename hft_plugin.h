@@ -0,0 +1,83 @@
+// HFT strategy plugin ABI
+// A plugin is a shared library exporting hft_plugin_init. The engine calls it
+// once after dlopen; the plugin registers one factory per strategy it offers.
+// Everything crossing the boundary is plain C data, so plugins can be built
+// with any compiler (or C++ standard library) and reloaded at runtime.
+#ifndef HFT_PLUGIN_H
+#define HFT_PLUGIN_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define HFT_PLUGIN_ABI_VERSION 1
+#define HFT_PLUGIN_INIT_SYMBOL "hft_plugin_init"
+
+enum { HFT_SIDE_BUY = 0, HFT_SIDE_SELL = 1 };
+
+// One market data update of a symbol on a venue
+typedef struct hft_tick {
+    uint16_t symbol;            // interned id; name via hft_host::symbol_name
+    uint8_t venue;
+    double price;
+    double volume;
+    double bid;
+    double ask;
+} hft_tick;
+
+// Top of the tick's venue book after the update
+typedef struct hft_top {
+    double bid;
+    double bid_quantity;
+    double ask;
+    double ask_quantity;
+} hft_top;
+
+// A new order requested by a strategy
+typedef struct hft_order {
+    uint16_t symbol;
+    uint8_t venue;
+    uint8_t side;               // HFT_SIDE_BUY / HFT_SIDE_SELL
+    double price;
+    double quantity;
+} hft_order;
+
+// Services the engine offers to plugins
+typedef struct hft_host {
+    uint32_t abi_version;
+    const char* (*symbol_name)(uint16_t symbol);
+} hft_host;
+
+// Strategy factory. All callbacks of an instance run on the thread that
+// evaluates strategies, one tick at a time.
+typedef struct hft_strategy_factory {
+    const char* name;           // redeploying a factory with the same name replaces it
+
+    // state/state_size: what the previous instance's save_state wrote, or
+    // NULL/0 on first load. Returns NULL on failure.
+    void* (*create)(const char* config, const void* state, size_t state_size);
+    void (*destroy)(void* instance);
+
+    // Writes up to max_orders orders; returns how many
+    size_t (*on_tick)(void* instance, const hft_tick* tick, const hft_top* top,
+                      hft_order* orders, size_t max_orders);
+
+    // Serializes state for the replacement instance; returns the bytes
+    // needed (nothing is written if that exceeds capacity). May be NULL.
+    size_t (*save_state)(void* instance, void* buffer, size_t capacity);
+} hft_strategy_factory;
+
+typedef void (*hft_register_fn)(void* registry, const hft_strategy_factory* factory);
+
+// Exported by every plugin; returns 0 on success. Factories must stay valid
+// until the library is unloaded (static storage).
+typedef int (*hft_plugin_init_fn)(const hft_host* host, hft_register_fn register_factory, void* registry);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // HFT_PLUGIN_H
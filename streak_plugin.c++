@@ -0,0 +1,78 @@
+// Example strategy plugin: trades short price streaks.
+// After `length` consecutive upticks it sells at the ask (fading the run),
+// after `length` downticks it buys at the bid. The per-symbol streak state is
+// handed to the replacement instance on redeploy, so a reload mid-streak
+// carries on where the old version stopped.
+//
+// Build:  g++ -std=c++17 -O3 -shared -fPIC -o streak_plugin.so streak_plugin.c++
+// Load:   l ./streak_plugin.so [config]   (config: streak length, default 5)
+#include "hft_plugin.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+struct SymbolState {
+    double last_price;
+    int streak;                 // > 0 upticks, < 0 downticks
+};
+
+struct StreakStrategy {
+    int length;
+    double quantity;
+    std::vector<SymbolState> symbols;   // indexed by symbol id
+};
+
+void* create(const char* config, const void* state, size_t state_size) {
+    auto* strategy = new StreakStrategy{5, 2.0, std::vector<SymbolState>(65536, SymbolState{0.0, 0})};
+    if (config && *config) strategy->length = std::max(1, std::atoi(config));
+    if (state && state_size == strategy->symbols.size() * sizeof(SymbolState)) {
+        std::memcpy(strategy->symbols.data(), state, state_size);
+    }
+    return strategy;
+}
+
+void destroy(void* instance) { delete static_cast<StreakStrategy*>(instance); }
+
+size_t onTick(void* instance, const hft_tick* tick, const hft_top* top, hft_order* orders, size_t max_orders) {
+    auto* strategy = static_cast<StreakStrategy*>(instance);
+    SymbolState& state = strategy->symbols[tick->symbol];
+    if (state.last_price > 0.0) {
+        if (tick->price > state.last_price) {
+            state.streak = state.streak > 0 ? state.streak + 1 : 1;
+        } else if (tick->price < state.last_price) {
+            state.streak = state.streak < 0 ? state.streak - 1 : -1;
+        }
+    }
+    state.last_price = tick->price;
+
+    if (max_orders == 0 || std::abs(state.streak) < strategy->length) return 0;
+    bool fade_rally = state.streak > 0;
+    state.streak = 0;
+    double price = fade_rally ? (top->ask_quantity > 0.0 ? top->ask : tick->ask)
+                              : (top->bid_quantity > 0.0 ? top->bid : tick->bid);
+    orders[0] = hft_order{tick->symbol, tick->venue,
+                          static_cast<uint8_t>(fade_rally ? HFT_SIDE_SELL : HFT_SIDE_BUY),
+                          price, strategy->quantity};
+    return 1;
+}
+
+size_t saveState(void* instance, void* buffer, size_t capacity) {
+    auto* strategy = static_cast<StreakStrategy*>(instance);
+    size_t bytes = strategy->symbols.size() * sizeof(SymbolState);
+    if (bytes <= capacity) std::memcpy(buffer, strategy->symbols.data(), bytes);
+    return bytes;
+}
+
+const hft_strategy_factory kFactory = {"Streak", create, destroy, onTick, saveState};
+
+}  // namespace
+
+extern "C" int hft_plugin_init(const hft_host* host, hft_register_fn register_factory, void* registry) {
+    if (host->abi_version != HFT_PLUGIN_ABI_VERSION) return -1;
+    register_factory(registry, &kFactory);
+    return 0;
+}